@@ -42,7 +42,12 @@ typedef signed int LONG;
 typedef enum { false, true } bool;
 #endif
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define USE_SSE2
+#endif
+
 #include "packer.h"
+#include "output.h"
 #include <stdlib.h>
 #include <malloc.h>
 #include <stdio.h>
@@ -63,7 +68,13 @@ typedef enum { false, true } bool;
 #endif
 
 void LoadPic (char *filename, UBYTE **data, int *width, int *height,
-	int *srcwidth, int *cx, int *cy, UBYTE *palette);
+	int *srcwidth, int *cx, int *cy, UBYTE *palette, UBYTE retrans);
+void ReleasePic (UBYTE *data);
+void UnsharePic (UBYTE **data, int width, int height);
+void ForgetPic (const char *filename);
+void EnablePicCache (void);
+void FlushPicCache (void);
+bool ProbePic (const char *filename, const char **format, int *width, int *height);
 
 int WriteConFont (const char *name, UBYTE *data, int width, int height, int srcwidth);
 
@@ -71,16 +82,27 @@ int WriteImage (const char *name, UBYTE *data, int width, int height,
 	int srcwidth, int cx, int cy, UBYTE *palette);
 
 int WritePCXfile (const char *name, UBYTE *data, int width, int height, int srcwidth, UBYTE *palette);
-int WriteBMPfile (const char *name, UBYTE *data, int width, int height, int srcwidth, UBYTE *palette);
+int WriteBMPfile (const char *name, UBYTE *data, int width, int height, int srcwidth, UBYTE *palette, bool rle);
 int WriteILBMfile (const char *name, UBYTE *data, int width, int height, int srcwidth,
 	int cx, int cy, UBYTE *palette);
+int WritePatchfile (const char *name, UBYTE *data, int width, int height, int srcwidth,
+	int cx, int cy);
+int WritePNGfile (const char *name, UBYTE *data, int width, int height, int srcwidth,
+	int cx, int cy, UBYTE *palette, int level);
 
-extern UBYTE RetransImage;
-
-UBYTE *ImageData;
-int ImageWidth, ImageHeight, ImageSrcWidth;
-int ImageCX, ImageCY;
-UBYTE ImagePalette[768];
+// What the command line's switches asked for. Each command gets its own,
+// so a server can run several at once.
+typedef struct
+{
+	UBYTE Retrans;			// the color to swap with 0 when loading
+	bool FontCache;
+	bool RebuildAll;
+	int TrimSpacing;		// -1 to leave glyphs alone
+	int PNGLevel;
+	bool WriteDeps;
+	char *DepFile;			// NULL to name it after the script or output
+	char *DepTarget;		// NULL to list every output
+} Options;
 
 typedef enum
 {
@@ -89,10 +111,15 @@ typedef enum
 	SHADING_None
 } ShadeType;
 
-void StartFont (const char *fontname, UBYTE *data, int width, int height, int srcwidth, UBYTE palette[768]);
-void GrabFont (int x, int y, int firstchar);
-bool EndFont (void);
-void SetFontShading (ShadeType shade);
+typedef struct FontBuilder FontBuilder;
+
+FontBuilder *StartFont (const char *fontname, UBYTE *data, int width, int height,
+	int srcwidth, UBYTE palette[768], const Options *options);
+void GrabFont (FontBuilder *font, int x, int y, int firstchar);
+bool EndFont (FontBuilder *font);
+char **FontFiles (FontBuilder *font, int *count);
+void SetFontShading (FontBuilder *font, ShadeType shade);
+void FreeFont (FontBuilder *font);
 
 
 typedef struct
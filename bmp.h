@@ -24,3 +24,6 @@ typedef struct
 	ULONG clrUsed;
 	ULONG clrImportant;
 } BitmapInfoHeader;
+
+#define BI_RGB		0
+#define BI_RLE8		1
@@ -0,0 +1,894 @@
+/*
+** deflate.c
+** A compact deflate compressor that produces zlib streams.
+**
+**---------------------------------------------------------------------------
+** Copyright 2001 Randy Heit
+** All rights reserved.
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions
+** are met:
+**
+** 1. Redistributions of source code must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. The name of the author may not be used to endorse or promote products
+**    derived from this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+** IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+** OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+** IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+** NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+** DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+** THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+** THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**---------------------------------------------------------------------------
+**
+** The input is cut into fixed-size chunks that are compressed
+** independently (each one may still refer back into the 32K before it)
+** and ended with an empty stored block so that they can simply be
+** concatenated. Because the chunk size does not depend on the number of
+** threads, neither does the output.
+*/
+
+#include "afx.h"
+#include "deflate.h"
+#include "threads.h"
+
+#define WINDOW_SIZE		32768
+#define HASH_BITS		15
+#define HASH_SIZE		(1<<HASH_BITS)
+#define MIN_MATCH		3
+#define MAX_MATCH		258
+#define TOO_FAR			4096		// length 3 matches further than this aren't worth it
+#define CHUNK_SIZE		(128*1024)
+#define BLOCK_SYMS		16384
+
+#define MAX_BITS		15
+#define MAX_CL_BITS		7
+#define NUM_LITLEN		286
+#define NUM_DIST		30
+#define NUM_CL			19
+
+typedef struct
+{
+	UWORD Chain;		// how many hash chain entries to look at
+	UWORD Nice;			// stop looking once we have a match this long
+	UWORD Lazy;			// try for a better match at the next byte if shorter than this; 0 = greedy
+} Effort;
+
+static const Effort Efforts[10] =
+{
+	{    0,   0,   0 },
+	{    4,   8,   0 },		// DEFLATE_FAST
+	{    8,  16,   0 },
+	{   32,  32,   0 },
+	{   16,  16,   4 },
+	{   32,  32,  16 },
+	{  128, 128,  16 },		// DEFLATE_DEFAULT
+	{  256, 128,  32 },
+	{ 1024, 258, 128 },
+	{ 4096, 258, 258 },		// DEFLATE_BEST
+};
+
+static const UWORD LenBase[29] =
+{
+	3,4,5,6,7,8,9,10,11,13,15,17,19,23,27,31,35,43,51,59,67,83,99,115,131,163,195,227,258
+};
+static const UBYTE LenExtra[29] =
+{
+	0,0,0,0,0,0,0,0,1,1,1,1,2,2,2,2,3,3,3,3,4,4,4,4,5,5,5,5,0
+};
+static const UWORD DistBase[30] =
+{
+	1,2,3,4,5,7,9,13,17,25,33,49,65,97,129,193,257,385,513,769,1025,1537,
+	2049,3073,4097,6145,8193,12289,16385,24577
+};
+static const UBYTE DistExtra[30] =
+{
+	0,0,0,0,1,1,2,2,3,3,4,4,5,5,6,6,7,7,8,8,9,9,10,10,11,11,12,12,13,13
+};
+static const UBYTE CLOrder[NUM_CL] =
+{
+	16,17,18,0,8,7,9,6,10,5,11,4,12,3,13,2,14,1,15
+};
+
+static bool TablesBuilt;
+static UBYTE LenCode[MAX_MATCH+1];
+static UBYTE DistCode[512];
+static UBYTE FixedLitLens[288], FixedDistLens[NUM_DIST];
+static UWORD FixedLitCodes[288], FixedDistCodes[NUM_DIST];
+static ULONG CRCTable[256];
+
+typedef struct
+{
+	UBYTE *Data;
+	int Size, Alloc;
+	ULONG Bits;
+	int NumBits;
+} BitStream;
+
+typedef struct
+{
+	const UBYTE *Src;		// the entire input
+	int Start, End;			// the part of it this chunk compresses
+	int Pos;				// how much of the input has been turned into symbols
+	int BlockStart;			// where the symbols in the current block start
+	const Effort *Effort;
+	int *Head;
+	int *Prev;				// indexed relative to Base
+	int Base;
+	UWORD LitLen[BLOCK_SYMS];
+	UWORD Dist[BLOCK_SYMS];	// 0 for literals
+	int NumSyms;
+	BitStream Out;
+} Deflater;
+
+typedef struct
+{
+	const UBYTE *Src;
+	int SrcLen;
+	int Level;
+	BitStream *Chunks;
+} ChunkJobs;
+
+static void BuildTables (void);
+static void CompressChunk (void *userdata, int chunk);
+static void FindMatches (Deflater *d);
+static void FlushBlock (Deflater *d, bool last);
+
+//==========================================================================
+//
+// Bit output
+//
+//==========================================================================
+
+static void PutByte (BitStream *bs, UBYTE b)
+{
+	if (bs->Size == bs->Alloc)
+	{
+		bs->Alloc = bs->Alloc ? bs->Alloc * 2 : 65536;
+		bs->Data = realloc (bs->Data, bs->Alloc);
+		if (bs->Data == NULL)
+		{
+			fprintf (stderr, "Out of memory\n");
+			exit (20);
+		}
+	}
+	bs->Data[bs->Size++] = b;
+}
+
+// Deflate packs values starting at the least significant bit.
+static void PutBits (BitStream *bs, ULONG bits, int count)
+{
+	bs->Bits |= bits << bs->NumBits;
+	bs->NumBits += count;
+	while (bs->NumBits >= 8)
+	{
+		PutByte (bs, (UBYTE)bs->Bits);
+		bs->Bits >>= 8;
+		bs->NumBits -= 8;
+	}
+}
+
+static void AlignBits (BitStream *bs)
+{
+	if (bs->NumBits > 0)
+	{
+		PutByte (bs, (UBYTE)bs->Bits);
+	}
+	bs->Bits = 0;
+	bs->NumBits = 0;
+}
+
+//==========================================================================
+//
+// Public interface
+//
+//==========================================================================
+
+UBYTE *ZlibCompress (const UBYTE *src, int srclen, int level, int *outlen)
+{
+	ChunkJobs jobs;
+	BitStream out;
+	ULONG adler;
+	int numchunks, i;
+	UBYTE flg;
+
+	if (level < DEFLATE_FAST)
+		level = DEFLATE_FAST;
+	else if (level > DEFLATE_BEST)
+		level = DEFLATE_BEST;
+
+	BuildTables ();
+
+	numchunks = (srclen + CHUNK_SIZE - 1) / CHUNK_SIZE;
+	if (numchunks < 1)
+		numchunks = 1;
+
+	jobs.Src = src;
+	jobs.SrcLen = srclen;
+	jobs.Level = level;
+	jobs.Chunks = calloc (numchunks, sizeof(BitStream));
+	if (jobs.Chunks == NULL)
+	{
+		fprintf (stderr, "Out of memory\n");
+		return NULL;
+	}
+	RunJobs (numchunks, CompressChunk, &jobs);
+
+	// 32K window, deflate, no dictionary
+	memset (&out, 0, sizeof(out));
+	flg = level == DEFLATE_FAST ? 0x00 : level == DEFLATE_BEST ? 0xC0 : 0x80;
+	flg += 31 - ((0x78 * 256 + flg) % 31);
+	PutByte (&out, 0x78);
+	PutByte (&out, flg);
+	for (i = 0; i < numchunks; ++i)
+	{
+		int j;
+
+		for (j = 0; j < jobs.Chunks[i].Size; ++j)
+		{
+			PutByte (&out, jobs.Chunks[i].Data[j]);
+		}
+		free (jobs.Chunks[i].Data);
+	}
+	free (jobs.Chunks);
+
+	adler = Adler32 (1, src, srclen);
+	PutByte (&out, (UBYTE)(adler >> 24));
+	PutByte (&out, (UBYTE)(adler >> 16));
+	PutByte (&out, (UBYTE)(adler >> 8));
+	PutByte (&out, (UBYTE)adler);
+
+	*outlen = out.Size;
+	return out.Data;
+}
+
+ULONG Adler32 (ULONG adler, const UBYTE *data, int len)
+{
+	ULONG a = adler & 0xFFFF;
+	ULONG b = adler >> 16;
+
+	while (len > 0)
+	{
+		// 5552 is the most bytes that can be summed before b might overflow
+		int n = len < 5552 ? len : 5552;
+
+		len -= n;
+		while (n-- > 0)
+		{
+			a += *data++;
+			b += a;
+		}
+		a %= 65521;
+		b %= 65521;
+	}
+	return (b << 16) | a;
+}
+
+ULONG CRC32 (ULONG crc, const UBYTE *data, int len)
+{
+	BuildTables ();
+
+	crc = ~crc;
+	while (len-- > 0)
+	{
+		crc = CRCTable[(crc ^ *data++) & 255] ^ (crc >> 8);
+	}
+	return ~crc;
+}
+
+//==========================================================================
+//
+// Tables
+//
+// These are built once from the main thread, before any workers run.
+//
+//==========================================================================
+
+static void BuildCodes (const UBYTE *lengths, int num, UWORD *codes);
+
+static void BuildTables (void)
+{
+	int i, j;
+
+	if (TablesBuilt)
+		return;
+
+	for (i = 0; i < 29; ++i)
+	{
+		for (j = LenBase[i]; j < LenBase[i] + (1 << LenExtra[i]) && j <= MAX_MATCH; ++j)
+		{
+			LenCode[j] = i;
+		}
+	}
+	// Length 258 can also be written as 227+31, but it has its own code.
+	LenCode[MAX_MATCH] = 28;
+
+	// Distances up to 256 are looked up directly. Longer ones are looked
+	// up by their upper bits, since the codes for them all have at least
+	// seven extra bits.
+	for (i = 0; i < 30; ++i)
+	{
+		for (j = DistBase[i]; j < DistBase[i] + (1 << DistExtra[i]); ++j)
+		{
+			if (j <= 256)
+				DistCode[j-1] = i;
+			else
+				DistCode[256 + ((j-1) >> 7)] = i;
+		}
+	}
+
+	for (i = 0; i < 288; ++i)
+	{
+		FixedLitLens[i] = i < 144 ? 8 : i < 256 ? 9 : i < 280 ? 7 : 8;
+	}
+	memset (FixedDistLens, 5, NUM_DIST);
+	BuildCodes (FixedLitLens, 288, FixedLitCodes);
+	BuildCodes (FixedDistLens, NUM_DIST, FixedDistCodes);
+
+	for (i = 0; i < 256; ++i)
+	{
+		ULONG c = i;
+		for (j = 0; j < 8; ++j)
+		{
+			c = c & 1 ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+		}
+		CRCTable[i] = c;
+	}
+
+	TablesBuilt = true;
+}
+
+static int GetDistCode (int dist)
+{
+	return dist <= 256 ? DistCode[dist-1] : DistCode[256 + ((dist-1) >> 7)];
+}
+
+//==========================================================================
+//
+// Huffman codes
+//
+//==========================================================================
+
+// Computes Huffman code lengths, none longer than maxbits. At least two
+// symbols always get codes so that the code is complete.
+static void BuildLengths (const int *freqs, int num, int maxbits, UBYTE *lengths)
+{
+	int syms[288];
+	int weight[2*288], parent[2*288];
+	int count[MAX_BITS+1];
+	int n, i, j, k, leaf, node;
+	ULONG total;
+
+	memset (lengths, 0, num);
+	for (i = n = 0; i < num; ++i)
+	{
+		if (freqs[i] != 0)
+			syms[n++] = i;
+	}
+	if (n < 2)
+	{
+		for (i = 0; n < 2; ++i)
+		{
+			if (n == 0 || syms[0] != i)
+				syms[n++] = i;
+		}
+	}
+
+	// Sort by increasing frequency
+	for (i = 1; i < n; ++i)
+	{
+		int sym = syms[i];
+		for (j = i; j > 0 && freqs[syms[j-1]] > freqs[sym]; --j)
+		{
+			syms[j] = syms[j-1];
+		}
+		syms[j] = sym;
+	}
+	for (i = 0; i < n; ++i)
+	{
+		weight[i] = freqs[syms[i]];
+	}
+
+	// Build the tree. Since leaves are sorted and new nodes are made in
+	// order of increasing weight, the two lightest are always at the
+	// front of one of the two queues.
+	leaf = 0;
+	node = n;
+	for (k = n; k < 2*n-1; ++k)
+	{
+		int pick[2];
+
+		for (i = 0; i < 2; ++i)
+		{
+			if (leaf < n && (node >= k || weight[leaf] <= weight[node]))
+				pick[i] = leaf++;
+			else
+				pick[i] = node++;
+		}
+		weight[k] = weight[pick[0]] + weight[pick[1]];
+		parent[pick[0]] = parent[pick[1]] = k;
+	}
+
+	// Reuse weight[] for the depths
+	weight[2*n-2] = 0;
+	memset (count, 0, sizeof(count));
+	for (k = 2*n-3; k >= 0; --k)
+	{
+		weight[k] = weight[parent[k]] + 1;
+		if (k < n)
+		{
+			count[weight[k] < maxbits ? weight[k] : maxbits]++;
+		}
+	}
+
+	// Clamping lengths to maxbits can oversubscribe the code, so
+	// lengthen shorter codes until it fits again.
+	for (total = 0, i = 1; i <= maxbits; ++i)
+	{
+		total += (ULONG)count[i] << (maxbits - i);
+	}
+	while (total > (1UL << maxbits))
+	{
+		count[maxbits]--;
+		for (i = maxbits - 1; i > 0; --i)
+		{
+			if (count[i] != 0)
+			{
+				count[i]--;
+				count[i+1] += 2;
+				break;
+			}
+		}
+		total--;
+	}
+
+	// The rarest symbols get the longest codes
+	for (i = maxbits, k = 0; i > 0; --i)
+	{
+		for (j = count[i]; j > 0; --j)
+		{
+			lengths[syms[k++]] = i;
+		}
+	}
+}
+
+// Assigns canonical codes. They are stored bit-reversed, since deflate
+// writes Huffman codes starting with their most significant bit.
+static void BuildCodes (const UBYTE *lengths, int num, UWORD *codes)
+{
+	int count[MAX_BITS+1], next[MAX_BITS+1];
+	int i, code;
+
+	memset (count, 0, sizeof(count));
+	for (i = 0; i < num; ++i)
+	{
+		count[lengths[i]]++;
+	}
+	count[0] = 0;
+	for (code = 0, i = 1; i <= MAX_BITS; ++i)
+	{
+		code = (code + count[i-1]) << 1;
+		next[i] = code;
+	}
+	for (i = 0; i < num; ++i)
+	{
+		if (lengths[i] != 0)
+		{
+			int c = next[lengths[i]]++;
+			int rev = 0, j;
+
+			for (j = lengths[i]; j > 0; --j)
+			{
+				rev = (rev << 1) | (c & 1);
+				c >>= 1;
+			}
+			codes[i] = rev;
+		}
+	}
+}
+
+//==========================================================================
+//
+// Matching
+//
+//==========================================================================
+
+static void CompressChunk (void *userdata, int chunk)
+{
+	ChunkJobs *jobs = (ChunkJobs *)userdata;
+	Deflater *d;
+	int i;
+
+	d = malloc (sizeof(Deflater));
+	if (d == NULL)
+	{
+		fprintf (stderr, "Out of memory\n");
+		exit (20);
+	}
+	memset (&d->Out, 0, sizeof(d->Out));
+	d->Src = jobs->Src;
+	d->Start = chunk * CHUNK_SIZE;
+	d->End = d->Start + CHUNK_SIZE < jobs->SrcLen ? d->Start + CHUNK_SIZE : jobs->SrcLen;
+	d->Base = d->Start > WINDOW_SIZE ? d->Start - WINDOW_SIZE : 0;
+	d->Pos = d->BlockStart = d->Start;
+	d->Effort = &Efforts[jobs->Level];
+	d->NumSyms = 0;
+	d->Head = malloc (HASH_SIZE * sizeof(int));
+	d->Prev = malloc ((d->End - d->Base + 1) * sizeof(int));
+	if (d->Head == NULL || d->Prev == NULL)
+	{
+		fprintf (stderr, "Out of memory\n");
+		exit (20);
+	}
+	for (i = 0; i < HASH_SIZE; ++i)
+	{
+		d->Head[i] = -1;
+	}
+
+	FindMatches (d);
+
+	if (d->End == jobs->SrcLen)
+	{
+		FlushBlock (d, true);
+		AlignBits (&d->Out);
+	}
+	else
+	{ // Sync flush: an empty stored block
+		FlushBlock (d, false);
+		PutBits (&d->Out, 0, 3);
+		AlignBits (&d->Out);
+		PutByte (&d->Out, 0x00);
+		PutByte (&d->Out, 0x00);
+		PutByte (&d->Out, 0xFF);
+		PutByte (&d->Out, 0xFF);
+	}
+
+	jobs->Chunks[chunk] = d->Out;
+	free (d->Head);
+	free (d->Prev);
+	free (d);
+}
+
+#define HASH(p)		((((p)[0] << 10) ^ ((p)[1] << 5) ^ (p)[2]) & (HASH_SIZE-1))
+
+static void InsertHash (Deflater *d, int pos)
+{
+	if (pos + MIN_MATCH <= d->End)
+	{
+		int h = HASH(d->Src + pos);
+		d->Prev[pos - d->Base] = d->Head[h];
+		d->Head[h] = pos;
+	}
+}
+
+static int LongestMatch (Deflater *d, int pos, int *matchdist)
+{
+	const UBYTE *src = d->Src;
+	int maxlen = d->End - pos < MAX_MATCH ? d->End - pos : MAX_MATCH;
+	int chain = d->Effort->Chain;
+	int best = MIN_MATCH - 1;
+	int cand;
+
+	if (maxlen < MIN_MATCH)
+		return 0;
+
+	cand = d->Prev[pos - d->Base];
+	while (cand >= 0 && pos - cand <= WINDOW_SIZE && chain-- > 0)
+	{
+		if (src[cand + best] == src[pos + best] && src[cand] == src[pos])
+		{
+			int len = 1;
+			while (len < maxlen && src[cand + len] == src[pos + len])
+				len++;
+			if (len > best)
+			{
+				best = len;
+				*matchdist = pos - cand;
+				if (len >= d->Effort->Nice || len == maxlen)
+					break;
+			}
+		}
+		cand = d->Prev[cand - d->Base];
+	}
+	if (best == MIN_MATCH && *matchdist > TOO_FAR)
+		return 0;
+	return best >= MIN_MATCH ? best : 0;
+}
+
+static void EmitLiteral (Deflater *d, UBYTE c)
+{
+	d->LitLen[d->NumSyms] = c;
+	d->Dist[d->NumSyms] = 0;
+	d->Pos++;
+	if (++d->NumSyms == BLOCK_SYMS)
+		FlushBlock (d, false);
+}
+
+static void EmitMatch (Deflater *d, int len, int dist)
+{
+	d->LitLen[d->NumSyms] = len;
+	d->Dist[d->NumSyms] = dist;
+	d->Pos += len;
+	if (++d->NumSyms == BLOCK_SYMS)
+		FlushBlock (d, false);
+}
+
+static void FindMatches (Deflater *d)
+{
+	int pos, len, dist = 0;
+	int prevlen = 0, prevdist = 0;
+	bool pending = false;
+
+	// Prime the hash chains with the window that precedes this chunk
+	for (pos = d->Base; pos < d->Start; ++pos)
+	{
+		InsertHash (d, pos);
+	}
+
+	if (d->Effort->Lazy == 0)
+	{ // Greedy: take the first match found
+		for (pos = d->Start; pos < d->End; )
+		{
+			InsertHash (d, pos);
+			len = LongestMatch (d, pos, &dist);
+			if (len != 0)
+			{
+				EmitMatch (d, len, dist);
+				while (--len > 0)
+				{
+					InsertHash (d, ++pos);
+				}
+				pos++;
+			}
+			else
+			{
+				EmitLiteral (d, d->Src[pos++]);
+			}
+		}
+		return;
+	}
+
+	// Lazy: before taking a match, see if the next byte starts a
+	// longer one.
+	for (pos = d->Start; pos < d->End; )
+	{
+		InsertHash (d, pos);
+		len = prevlen < d->Effort->Lazy ? LongestMatch (d, pos, &dist) : 0;
+
+		if (prevlen != 0 && len <= prevlen)
+		{
+			EmitMatch (d, prevlen, prevdist);
+			for (pos++, prevlen -= 2; prevlen > 0; --prevlen)
+			{
+				InsertHash (d, pos++);
+			}
+			pending = false;
+		}
+		else
+		{
+			if (pending)
+			{
+				EmitLiteral (d, d->Src[pos-1]);
+			}
+			prevlen = len;
+			prevdist = dist;
+			pending = true;
+			pos++;
+		}
+	}
+	if (pending)
+	{
+		if (prevlen != 0)
+			EmitMatch (d, prevlen, prevdist);
+		else
+			EmitLiteral (d, d->Src[pos-1]);
+	}
+}
+
+//==========================================================================
+//
+// Block output
+//
+//==========================================================================
+
+static void PutSymbols (Deflater *d, const UWORD *litcodes, const UBYTE *litlens,
+	const UWORD *distcodes, const UBYTE *distlens)
+{
+	BitStream *bs = &d->Out;
+	int i;
+
+	for (i = 0; i < d->NumSyms; ++i)
+	{
+		int dist = d->Dist[i];
+
+		if (dist == 0)
+		{
+			PutBits (bs, litcodes[d->LitLen[i]], litlens[d->LitLen[i]]);
+		}
+		else
+		{
+			int len = d->LitLen[i];
+			int code = LenCode[len];
+
+			PutBits (bs, litcodes[257+code], litlens[257+code]);
+			if (LenExtra[code])
+				PutBits (bs, len - LenBase[code], LenExtra[code]);
+			code = GetDistCode (dist);
+			PutBits (bs, distcodes[code], distlens[code]);
+			if (DistExtra[code])
+				PutBits (bs, dist - DistBase[code], DistExtra[code]);
+		}
+	}
+	PutBits (bs, litcodes[256], litlens[256]);
+}
+
+// Writes out the symbols collected so far as whichever of a stored,
+// fixed or dynamic block comes out smallest.
+static void FlushBlock (Deflater *d, bool last)
+{
+	int litfreq[NUM_LITLEN], distfreq[NUM_DIST], clfreq[NUM_CL];
+	UBYTE litlens[NUM_LITLEN], distlens[NUM_DIST], cllens[NUM_CL];
+	UWORD litcodes[NUM_LITLEN], distcodes[NUM_DIST], clcodes[NUM_CL];
+	UBYTE all[NUM_LITLEN+NUM_DIST];
+	UBYTE clsyms[NUM_LITLEN+NUM_DIST], clextra[NUM_LITLEN+NUM_DIST];
+	int numcl, hlit, hdist, hclen;
+	ULONG extrabits, fixedcost, dyncost, storedcost;
+	int rawlen = d->Pos - d->BlockStart;
+	int i, j;
+
+	if (d->NumSyms == 0 && !last)
+		return;
+
+	memset (litfreq, 0, sizeof(litfreq));
+	memset (distfreq, 0, sizeof(distfreq));
+	extrabits = 0;
+	for (i = 0; i < d->NumSyms; ++i)
+	{
+		if (d->Dist[i] == 0)
+		{
+			litfreq[d->LitLen[i]]++;
+		}
+		else
+		{
+			int code = LenCode[d->LitLen[i]];
+			litfreq[257+code]++;
+			extrabits += LenExtra[code];
+			code = GetDistCode (d->Dist[i]);
+			distfreq[code]++;
+			extrabits += DistExtra[code];
+		}
+	}
+	litfreq[256] = 1;
+
+	BuildLengths (litfreq, NUM_LITLEN, MAX_BITS, litlens);
+	BuildLengths (distfreq, NUM_DIST, MAX_BITS, distlens);
+	BuildCodes (litlens, NUM_LITLEN, litcodes);
+	BuildCodes (distlens, NUM_DIST, distcodes);
+
+	// Run-length encode the code lengths
+	for (hlit = NUM_LITLEN; hlit > 257 && litlens[hlit-1] == 0; --hlit)
+		;
+	for (hdist = NUM_DIST; hdist > 1 && distlens[hdist-1] == 0; --hdist)
+		;
+	memcpy (all, litlens, hlit);
+	memcpy (all + hlit, distlens, hdist);
+	memset (clfreq, 0, sizeof(clfreq));
+	for (i = numcl = 0; i < hlit + hdist; )
+	{
+		UBYTE cur = all[i];
+		int run;
+
+		for (run = 1; i + run < hlit + hdist && all[i+run] == cur; ++run)
+			;
+		if (cur == 0 && run >= 3)
+		{
+			run = run < 138 ? run : 138;
+			clsyms[numcl] = run >= 11 ? 18 : 17;
+			clextra[numcl++] = run - (run >= 11 ? 11 : 3);
+		}
+		else if (cur != 0 && run >= 4)
+		{ // The first one must be given explicitly before it can repeat
+			clsyms[numcl] = cur;
+			clextra[numcl++] = 0;
+			clfreq[cur]++;
+			run = run - 1 < 6 ? run - 1 : 6;
+			clsyms[numcl] = 16;
+			clextra[numcl++] = run - 3;
+			run++;
+		}
+		else
+		{
+			clsyms[numcl] = cur;
+			clextra[numcl++] = 0;
+			run = 1;
+		}
+		clfreq[clsyms[numcl-1]]++;
+		i += run;
+	}
+	BuildLengths (clfreq, NUM_CL, MAX_CL_BITS, cllens);
+	BuildCodes (cllens, NUM_CL, clcodes);
+	for (hclen = NUM_CL; hclen > 4 && cllens[CLOrder[hclen-1]] == 0; --hclen)
+		;
+
+	// Compare the costs of the three block types
+	dyncost = 3 + 5 + 5 + 4 + 3 * hclen;
+	for (i = 0; i < numcl; ++i)
+	{
+		dyncost += cllens[clsyms[i]];
+		dyncost += clsyms[i] == 16 ? 2 : clsyms[i] == 17 ? 3 : clsyms[i] == 18 ? 7 : 0;
+	}
+	fixedcost = 3 + extrabits;
+	dyncost += extrabits;
+	for (i = 0; i < NUM_LITLEN; ++i)
+	{
+		fixedcost += litfreq[i] * FixedLitLens[i];
+		dyncost += litfreq[i] * litlens[i];
+	}
+	for (i = 0; i < NUM_DIST; ++i)
+	{
+		fixedcost += distfreq[i] * 5;
+		dyncost += distfreq[i] * distlens[i];
+	}
+	storedcost = rawlen * 8 + (rawlen / 65535 + 1) * (3 + 7 + 32);
+
+	if (storedcost < fixedcost && storedcost < dyncost)
+	{
+		const UBYTE *raw = d->Src + d->BlockStart;
+
+		do
+		{
+			int piece = rawlen < 65535 ? rawlen : 65535;
+
+			rawlen -= piece;
+			PutBits (&d->Out, last && rawlen == 0, 1);
+			PutBits (&d->Out, 0, 2);
+			AlignBits (&d->Out);
+			PutByte (&d->Out, piece & 255);
+			PutByte (&d->Out, piece >> 8);
+			PutByte (&d->Out, ~piece & 255);
+			PutByte (&d->Out, (~piece >> 8) & 255);
+			for (j = 0; j < piece; ++j)
+			{
+				PutByte (&d->Out, *raw++);
+			}
+		} while (rawlen > 0);
+	}
+	else if (fixedcost <= dyncost)
+	{
+		PutBits (&d->Out, last, 1);
+		PutBits (&d->Out, 1, 2);
+		PutSymbols (d, FixedLitCodes, FixedLitLens, FixedDistCodes, FixedDistLens);
+	}
+	else
+	{
+		PutBits (&d->Out, last, 1);
+		PutBits (&d->Out, 2, 2);
+		PutBits (&d->Out, hlit - 257, 5);
+		PutBits (&d->Out, hdist - 1, 5);
+		PutBits (&d->Out, hclen - 4, 4);
+		for (i = 0; i < hclen; ++i)
+		{
+			PutBits (&d->Out, cllens[CLOrder[i]], 3);
+		}
+		for (i = 0; i < numcl; ++i)
+		{
+			int sym = clsyms[i];
+			PutBits (&d->Out, clcodes[sym], cllens[sym]);
+			if (sym >= 16)
+				PutBits (&d->Out, clextra[i], sym == 16 ? 2 : sym == 17 ? 3 : 7);
+		}
+		PutSymbols (d, litcodes, litlens, distcodes, distlens);
+	}
+
+	d->NumSyms = 0;
+	d->BlockStart = d->Pos;
+}
@@ -0,0 +1,19 @@
+#ifndef DEFLATE_H
+#define DEFLATE_H
+/*----------------------------------------------------------------------*
+ * deflate.h  A small zlib-format compressor for writing PNGs.
+ *
+ * Effort levels run from DEFLATE_FAST (1) to DEFLATE_BEST (9), in the
+ * same spirit as zlib's. The output is identical no matter how many
+ * threads did the work.
+ *----------------------------------------------------------------------*/
+
+#define DEFLATE_FAST	1
+#define DEFLATE_DEFAULT	6
+#define DEFLATE_BEST	9
+
+extern UBYTE *ZlibCompress (const UBYTE *src, int srclen, int level, int *outlen);
+extern ULONG Adler32 (ULONG adler, const UBYTE *data, int len);
+extern ULONG CRC32 (ULONG crc, const UBYTE *data, int len);
+
+#endif
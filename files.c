@@ -0,0 +1,471 @@
+/*
+** files.c
+** Finds the files that match a wildcard pattern, watches files for
+** changes, and writes dependency files.
+**
+**---------------------------------------------------------------------------
+** Copyright 2001 Randy Heit
+** All rights reserved.
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions
+** are met:
+**
+** 1. Redistributions of source code must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. The name of the author may not be used to endorse or promote products
+**    derived from this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+** IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+** OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+** IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+** NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+** DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+** THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+** THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**---------------------------------------------------------------------------
+*/
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <ctype.h>
+#include <unistd.h>
+#endif
+#include <sys/types.h>
+#include <sys/stat.h>
+
+// Don't include afx.h here; its typedefs clash with windows.h.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "output.h"
+#include "files.h"
+
+#ifdef _WIN32
+#define stricmp _stricmp
+#else
+#define stricmp strcasecmp
+#include <strings.h>
+#endif
+
+typedef struct
+{
+	char **Names;
+	int Count, Max;
+} FileList;
+
+static char *AddFile (FileList *list, const char *dir, int dirlen, const char *name)
+{
+	char *path;
+
+	if (list->Count + 1 >= list->Max)
+	{
+		char **grown;
+
+		list->Max = list->Max ? list->Max * 2 : 64;
+		grown = realloc (list->Names, list->Max * sizeof(char *));
+		if (grown == NULL)
+			return NULL;
+		list->Names = grown;
+	}
+	path = malloc (dirlen + strlen (name) + 1);
+	if (path == NULL)
+		return NULL;
+	memcpy (path, dir, dirlen);
+	strcpy (path + dirlen, name);
+	list->Names[list->Count++] = path;
+	return path;
+}
+
+static int CompareNames (const void *arg1, const void *arg2)
+{
+	return stricmp (*(char *const *)arg1, *(char *const *)arg2);
+}
+
+#ifndef _WIN32
+// Returns true if name matches pattern, ignoring case.
+static int WildMatch (const char *pattern, const char *name)
+{
+	for (; *pattern != 0; ++pattern, ++name)
+	{
+		if (*pattern == '*')
+		{
+			while (*++pattern == '*')
+				;
+			if (*pattern == 0)
+				return 1;
+			for (; *name != 0; ++name)
+			{
+				if (WildMatch (pattern, name))
+					return 1;
+			}
+			return 0;
+		}
+		if (*name == 0 || (*pattern != '?' &&
+			tolower ((unsigned char)*pattern) != tolower ((unsigned char)*name)))
+		{
+			return 0;
+		}
+	}
+	return *name == 0;
+}
+#endif
+
+char **MatchFiles (const char *pattern, int *count)
+{
+	FileList list = { NULL, 0, 0 };
+	const char *filepart;
+	int dirlen;
+
+	// Matches are returned with the same directory the pattern has.
+	for (filepart = pattern + strlen (pattern); filepart > pattern; --filepart)
+	{
+		if (filepart[-1] == '/' || filepart[-1] == '\\' || filepart[-1] == ':')
+			break;
+	}
+	dirlen = filepart - pattern;
+
+#ifdef _WIN32
+	{
+		WIN32_FIND_DATA found;
+		HANDLE search = FindFirstFile (pattern, &found);
+
+		if (search != INVALID_HANDLE_VALUE)
+		{
+			do
+			{
+				if (!(found.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY))
+					AddFile (&list, pattern, dirlen, found.cFileName);
+			} while (FindNextFile (search, &found));
+			FindClose (search);
+		}
+	}
+#else
+	{
+		char *dirname = malloc (dirlen + 2);
+		struct dirent *entry;
+		DIR *dir;
+
+		if (dirname == NULL)
+			return NULL;
+		memcpy (dirname, pattern, dirlen);
+		strcpy (dirname + dirlen, dirlen ? "." : "./");
+		dir = opendir (dirname);
+		if (dir != NULL)
+		{
+			while ((entry = readdir (dir)) != NULL)
+			{
+				struct stat st;
+				char *path;
+
+				if (entry->d_name[0] == '.' && filepart[0] != '.')
+					continue;
+				if (!WildMatch (filepart, entry->d_name))
+					continue;
+				path = AddFile (&list, pattern, dirlen, entry->d_name);
+				if (path != NULL && (stat (path, &st) != 0 || S_ISDIR (st.st_mode)))
+				{
+					free (path);
+					list.Count--;
+				}
+			}
+			closedir (dir);
+		}
+		free (dirname);
+	}
+#endif
+
+	*count = list.Count;
+	if (list.Count == 0)
+	{
+		free (list.Names);
+		return NULL;
+	}
+	qsort (list.Names, list.Count, sizeof(char *), CompareNames);
+	list.Names[list.Count] = NULL;
+	return list.Names;
+}
+
+void FreeFileList (char **list)
+{
+	int i;
+
+	if (list != NULL)
+	{
+		for (i = 0; list[i] != NULL; ++i)
+		{
+			free (list[i]);
+		}
+		free (list);
+	}
+}
+
+// How often WaitForChange looks at the files, and how long they must
+// stay the same before it returns. Editors often save in several steps.
+#define POLL_MS			250
+#define SETTLE_MS		200
+
+typedef struct
+{
+	char *Name;
+	int IsPattern;
+	unsigned long Size;		// for a pattern, how many files match
+	long MTime;				// for a pattern, a hash of their names
+} WatchedFile;
+
+struct FileWatch
+{
+	WatchedFile *Files;
+	int Count, Max;
+	int Sorted;
+};
+
+static void Pause (int ms)
+{
+#ifdef _WIN32
+	Sleep (ms);
+#else
+	usleep (ms * 1000);
+#endif
+}
+
+static void StampFile (WatchedFile *file)
+{
+	if (file->IsPattern)
+	{
+		char **names;
+		unsigned long hash = 0;
+		int count, i;
+		const char *p;
+
+		names = MatchFiles (file->Name, &count);
+		for (i = 0; i < count; ++i)
+		{
+			for (p = names[i]; *p != 0; ++p)
+			{
+				hash = hash * 31 + (unsigned char)*p;
+			}
+			hash = hash * 31;
+		}
+		FreeFileList (names);
+		file->Size = count;
+		file->MTime = (long)hash;
+	}
+	else
+	{
+		struct stat st;
+
+		if (stat (file->Name, &st) == 0)
+		{
+			file->Size = (unsigned long)st.st_size;
+			file->MTime = (long)st.st_mtime;
+		}
+		else
+		{
+			file->Size = (unsigned long)-1;
+			file->MTime = 0;
+		}
+	}
+}
+
+FileWatch *NewFileWatch (void)
+{
+	FileWatch *watch = calloc (1, sizeof(FileWatch));
+
+	if (watch == NULL)
+	{
+		fprintf (stderr, "Out of memory\n");
+		exit (20);
+	}
+	return watch;
+}
+
+static void AddWatch (FileWatch *watch, const char *name, int ispattern)
+{
+	WatchedFile *file;
+
+	if (watch->Count == watch->Max)
+	{
+		watch->Max = watch->Max ? watch->Max * 2 : 64;
+		watch->Files = realloc (watch->Files, watch->Max * sizeof(WatchedFile));
+	}
+	if (watch->Files == NULL || (name = strdup (name)) == NULL)
+	{
+		fprintf (stderr, "Out of memory\n");
+		exit (20);
+	}
+	file = &watch->Files[watch->Count++];
+	file->Name = (char *)name;
+	file->IsPattern = ispattern;
+	StampFile (file);
+	watch->Sorted = 0;
+}
+
+// The file is looked at now, so a change made while it is being used
+// will still be noticed.
+void WatchFile (FileWatch *watch, const char *name)
+{
+	AddWatch (watch, name, 0);
+}
+
+void WatchPattern (FileWatch *watch, const char *pattern)
+{
+	AddWatch (watch, pattern, 1);
+}
+
+static int CompareWatched (const void *arg1, const void *arg2)
+{
+	const WatchedFile *a = (const WatchedFile *)arg1;
+	const WatchedFile *b = (const WatchedFile *)arg2;
+
+	if (a->IsPattern != b->IsPattern)
+		return a->IsPattern - b->IsPattern;
+	return strcmp (a->Name, b->Name);
+}
+
+// Returns true if any file is different from when it was last looked at.
+static int RestampFiles (FileWatch *watch)
+{
+	int changed = 0;
+	int i;
+
+	for (i = 0; i < watch->Count; ++i)
+	{
+		WatchedFile now = watch->Files[i];
+
+		StampFile (&now);
+		if (now.Size != watch->Files[i].Size || now.MTime != watch->Files[i].MTime)
+		{
+			watch->Files[i] = now;
+			changed = 1;
+		}
+	}
+	return changed;
+}
+
+void WaitForChange (FileWatch *watch)
+{
+	int i, j;
+
+	// The same file is often added more than once.
+	if (!watch->Sorted && watch->Count > 0)
+	{
+		qsort (watch->Files, watch->Count, sizeof(WatchedFile), CompareWatched);
+		for (i = j = 1; i < watch->Count; ++i)
+		{
+			if (CompareWatched (&watch->Files[i], &watch->Files[j-1]) == 0)
+				free (watch->Files[i].Name);
+			else
+				watch->Files[j++] = watch->Files[i];
+		}
+		watch->Count = j;
+		watch->Sorted = 1;
+	}
+
+	do
+	{
+		Pause (POLL_MS);
+	} while (!RestampFiles (watch));
+
+	do
+	{
+		Pause (SETTLE_MS);
+	} while (RestampFiles (watch));
+}
+
+void FreeFileWatch (FileWatch *watch)
+{
+	int i;
+
+	if (watch != NULL)
+	{
+		for (i = 0; i < watch->Count; ++i)
+		{
+			free (watch->Files[i].Name);
+		}
+		free (watch->Files);
+		free (watch);
+	}
+}
+
+// Writes a file name, escaping the characters make treats specially.
+static void WriteDepName (FILE *file, const char *name)
+{
+	for (; *name != 0; ++name)
+	{
+		if (*name == ' ' || *name == '\t' || *name == '#')
+			fputc ('\\', file);
+		else if (*name == '$')
+			fputc ('$', file);
+		fputc (*name, file);
+	}
+}
+
+int WriteDepFile (const char *depname, const char *target,
+	char **outputs, int numoutputs, char **inputs, int numinputs)
+{
+	FILE *file = fopen (depname, "w");
+	int i;
+
+	if (file == NULL)
+	{
+		Eprintf ("Could not write %s\n", depname);
+		return 1;
+	}
+
+	if (target != NULL)
+	{
+		WriteDepName (file, target);
+	}
+	else
+	{
+		for (i = 0; i < numoutputs; ++i)
+		{
+			if (i > 0)
+				fputs (" \\\n ", file);
+			WriteDepName (file, outputs[i]);
+		}
+	}
+	fputc (':', file);
+
+	// Each input is only listed once.
+	qsort (inputs, numinputs, sizeof(char *), CompareNames);
+	for (i = 0; i < numinputs; ++i)
+	{
+		if (i == 0 || CompareNames (&inputs[i], &inputs[i-1]) != 0)
+		{
+			fputs (" \\\n  ", file);
+			WriteDepName (file, inputs[i]);
+		}
+	}
+	fputc ('\n', file);
+
+	if (target == NULL)
+	{
+		for (i = 0; i < numinputs; ++i)
+		{
+			if (i == 0 || CompareNames (&inputs[i], &inputs[i-1]) != 0)
+			{
+				fputc ('\n', file);
+				WriteDepName (file, inputs[i]);
+				fputs (":\n", file);
+			}
+		}
+	}
+
+	if (fclose (file) != 0)
+	{
+		Eprintf ("Could not write %s\n", depname);
+		return 1;
+	}
+	return 0;
+}
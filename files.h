@@ -0,0 +1,32 @@
+#ifndef FILES_H
+#define FILES_H
+
+/* Returns a sorted, NULL-terminated list of the files that match a
+ * pattern, or NULL if there are none. * and ? are only understood in
+ * the last part of the path, and case doesn't matter.
+ */
+char **MatchFiles (const char *pattern, int *count);
+void FreeFileList (char **list);
+
+/* Remembers how a set of files looked, so that WaitForChange can return
+ * once one of them is different. For a pattern, it is the list of files
+ * that match which gets watched.
+ */
+typedef struct FileWatch FileWatch;
+
+FileWatch *NewFileWatch (void);
+void WatchFile (FileWatch *watch, const char *name);
+void WatchPattern (FileWatch *watch, const char *pattern);
+void WaitForChange (FileWatch *watch);
+void FreeFileWatch (FileWatch *watch);
+
+/* Writes a make dependency file saying that the outputs are built from
+ * the inputs, with an empty rule for each input so make doesn't stop when
+ * one goes away. If target isn't NULL, it is the only thing the file
+ * names as being built, and the empty rules are left out; that is the
+ * form ninja wants. The inputs get sorted. Returns non-zero on failure.
+ */
+int WriteDepFile (const char *depname, const char *target,
+	char **outputs, int numoutputs, char **inputs, int numinputs);
+
+#endif
@@ -32,54 +32,126 @@
 */
 
 #include "afx.h"
+#include "deflate.h"
+#include "threads.h"
+
+#ifdef _MSC_VER
+#define snprintf _snprintf
+#endif
+
+// Big enough for any code CharName is given
+#define CHARNAME_SIZE 32
+
+#ifdef USE_SSE2
+#include <emmintrin.h>
+#endif
 
 #define FONT_BORDER		255
+#define MAX_CODEPOINT	0x10FFFF
+#define ID_FGC3			MAKE_ID('F','G','C','3')
+#define IS_BORDER(x,y)	(font->Bitmap[(x)+(y)*font->Pitch] == FONT_BORDER)
 
 typedef struct
 {
+	int Code;
+	int Order;			// if a code is grabbed twice, the later one wins
 	UWORD x, y, w;
 } CharRect;
 
-static int compare (const void *arg1, const void *arg2);
+static void SortByLuma (UBYTE *colors, int count, const UBYTE *palette);
+static void AllocColumnBorders (FontBuilder *font);
+static void MarkRowBorders (FontBuilder *font, int y);
+static int NextBorderInRow (FontBuilder *font, int x, int y);
+static int NextBorderInColumn (FontBuilder *font, int x, int y);
+static void DetectFontGrid (FontBuilder *font, int firstchar);
+static bool AddChar (FontBuilder *font, int code, int x, int y, int w);
+static LONG TrimGlyphs (FontBuilder *font, int spacing);
+static int CompareChars (const void *arg1, const void *arg2);
+static const char *CharName (int code, char name[CHARNAME_SIZE]);
+
+// Everything about the font being built. Each font has its own, so
+// several can be built at once.
+struct FontBuilder
+{
+	FontHeader Header;
+	char *Name;
+	UBYTE Palette[768];
+	CharRect *Chars;		// only glyphs that aren't empty
+	int NumChars, MaxChars;
+	int FirstChar, LastChar;
+	int Width, Height, Pitch;
+	UBYTE *Bitmap;
+	UBYTE Remap255;
+	int TrimSpacing;		// from the options, -1 to not trim
+	bool CacheGlyphs;
+
+	// Bit y of column x's words is set if (x,y) is a border pixel. This
+	// lets GrabFont look down a column without striding through the image.
+	ULONG *ColumnBorders;
+	int ColumnWords;
+
+	// The files EndFont wrote. A font with more than 256 characters is
+	// written as one file for each page.
+	char **WrittenFiles;
+	int NumWrittenFiles;
 
-FontHeader Font;
-char *FontName;
-UBYTE FontPalette[768];
-CharRect Chars[256];
-int FontWidth, FontHeight, FontPitch;
-UBYTE *FontBitmap;
-UBYTE Font255Remap;
+	struct CachedGlyph *GlyphCache;
+	int GlyphCacheSize;
+};
 
-void StartFont (const char *fontname, UBYTE *data, int width, int height,
-				int srcwidth, UBYTE palette[768])
+// Starts building a font from the image, which is remapped in place and
+// must stay around until EndFont. Returns NULL if there is no memory.
+FontBuilder *StartFont (const char *fontname, UBYTE *data, int width, int height,
+	int srcwidth, UBYTE palette[768], const Options *options)
 {
-	UBYTE used[256];
+	FontBuilder *font;
+	UBYTE used[4][256];
 	UBYTE remap[256], unmap[256];
 	int x, y;
 	UBYTE color255;
 	int color255best;
 
 	// Set up font book keeping
-	memset (&Font, 0, sizeof(Font));
-	memset (Chars, 0, sizeof(Chars));
-	memcpy (FontPalette, palette, 768);
-	FontName = strdup (fontname);
-	FontWidth = srcwidth;
-	FontPitch = width;
-	FontHeight = height;
-	FontBitmap = data;
-	Font.FirstChar = 255;
-
-	// Find out which of the image's colors are actually used
-	memset (used, 0, 256);
+	font = calloc (1, sizeof(FontBuilder));
+	if (font == NULL || (font->Name = strdup (fontname)) == NULL)
+	{
+		Eprintf ("Out of memory\n");
+		free (font);
+		return NULL;
+	}
+	memcpy (font->Palette, palette, 768);
+	font->Width = srcwidth;
+	font->Pitch = width;
+	font->Height = height;
+	font->Bitmap = data;
+	font->FirstChar = MAX_CODEPOINT + 1;
+	font->LastChar = -1;
+	font->TrimSpacing = options->TrimSpacing;
+	font->CacheGlyphs = options->FontCache;
+
+	// Find out which of the image's colors are actually used. Neighboring
+	// pixels are often the same color, so each of four pixels in a row
+	// marks its own table to keep the stores from waiting on each other.
+	memset (used, 0, sizeof(used));
 	for (y = 0; y < height; ++y)
 	{
 		UBYTE *colors = data + y*width;
-		for (x = 0; x < srcwidth; ++x)
+		for (x = 0; x + 4 <= srcwidth; x += 4)
 		{
-			used[*colors++] = 1;
+			used[0][colors[x  ]] = 1;
+			used[1][colors[x+1]] = 1;
+			used[2][colors[x+2]] = 1;
+			used[3][colors[x+3]] = 1;
+		}
+		for (; x < srcwidth; ++x)
+		{
+			used[0][colors[x]] = 1;
 		}
 	}
+	for (x = 0; x < 256; ++x)
+	{
+		used[0][x] |= used[1][x] | used[2][x] | used[3][x];
+	}
 
 	// Move those colors to the front of the palette.
 	// Color 0 is left alone, because it is the transparent color.
@@ -87,10 +159,10 @@ void StartFont (const char *fontname, UBYTE *data, int width, int height,
 	memset (remap, 0, 256);
 	memset (unmap, 0, 256);
 	remap[255] = 255;
-	used[0] = 1;
+	used[0][0] = 1;
 	for (x = y = 0; x < 255; ++x)
 	{
-		if (used[x])
+		if (used[0][x])
 		{
 			remap[x] = y;
 			unmap[y] = x;
@@ -99,8 +171,8 @@ void StartFont (const char *fontname, UBYTE *data, int width, int height,
 	}
 
 	// Sort the palette by increasing brightness
-	Font.PaletteSize = y;
-	qsort (unmap+1, y-1, 1, compare);
+	font->Header.PaletteSize = y;
+	SortByLuma (unmap+1, y-1, palette);
 	color255 = 0;
 	color255best = 256*256*4;
 	for (x = 1; x < y; ++x)
@@ -108,9 +180,9 @@ void StartFont (const char *fontname, UBYTE *data, int width, int height,
 		int dist, rd, gd, bd;
 
 		remap[unmap[x]] = x;
-		rd = FontPalette[x*3  ] = palette[unmap[x]*3  ];
-		gd = FontPalette[x*3+1] = palette[unmap[x]*3+1];
-		bd = FontPalette[x*3+2] = palette[unmap[x]*3+2];
+		rd = font->Palette[x*3  ] = palette[unmap[x]*3  ];
+		gd = font->Palette[x*3+1] = palette[unmap[x]*3+1];
+		bd = font->Palette[x*3+2] = palette[unmap[x]*3+2];
 
 		rd -= palette[255*3  ];
 		gd -= palette[255*3+1];
@@ -126,20 +198,36 @@ void StartFont (const char *fontname, UBYTE *data, int width, int height,
 
 	// Fix fonts that include palette entry 255 within
 	// a glyph's bounding box.
-	Font255Remap = color255;
+	font->Remap255 = color255;
 
-	// Now remap the source image to use the new colors.
+	// Now remap the source image to use the new colors. Color 255 stays
+	// put, so the border map can be built from each row while it's still
+	// in the cache.
+	AllocColumnBorders (font);
 	for (y = 0; y < height; ++y)
 	{
 		UBYTE *colors = data + y*width;
-		for (x = 0; x < srcwidth; ++x)
+		for (x = 0; x + 4 <= srcwidth; x += 4)
+		{
+			UBYTE c0 = remap[colors[x  ]];
+			UBYTE c1 = remap[colors[x+1]];
+			UBYTE c2 = remap[colors[x+2]];
+			UBYTE c3 = remap[colors[x+3]];
+			colors[x  ] = c0;
+			colors[x+1] = c1;
+			colors[x+2] = c2;
+			colors[x+3] = c3;
+		}
+		for (; x < srcwidth; ++x)
 		{
 			colors[x] = remap[colors[x]];
 		}
+		MarkRowBorders (font, y);
 	}
+	return font;
 }
 
-void GrabFont (int xl, int yl, int firstchar)
+void GrabFont (FontBuilder *font, int xl, int yl, int firstchar)
 {
 	int glyph = firstchar;
 	int x, y, r, h;
@@ -148,17 +236,17 @@ void GrabFont (int xl, int yl, int firstchar)
 	yl++;
 	xl++;
 
-	for (y = yl; y < FontHeight; )
+	for (y = yl; y < font->Height; )
 	{
-		for (x = xl; x < FontWidth; )
+		for (x = xl; x < font->Width; )
 		{
-			if (glyph < 0 || glyph > 255)
+			if (glyph < 0 || glyph > MAX_CODEPOINT)
 			{
-				fprintf (stderr, "%s has glyphs out of range\n", FontName);
+				Eprintf ("%s has glyphs out of range\n", font->Name);
 				return;
 			}
 
-			if (FontBitmap[x+y*FontPitch] == FONT_BORDER)
+			if (font->Bitmap[x+y*font->Pitch] == FONT_BORDER)
 			{ // Character is empty, so skip it
 				glyph++;
 				x++;
@@ -166,19 +254,15 @@ void GrabFont (int xl, int yl, int firstchar)
 			}
 
 			// Determine glyph height
-			for (r = y+1; r < FontHeight; ++r)
-			{
-				if (FontBitmap[x+r*FontPitch] == FONT_BORDER)
-					break;
-			}
-			if (Font.FontHeight == 0)
+			r = NextBorderInColumn (font, x, y+1);
+			if (font->Header.FontHeight == 0)
 			{
 				if (r - y == 0)
 				{
-					fprintf (stderr, "Font has 0 height!\n");
+					Eprintf ("Font has 0 height!\n");
 					return;
 				}
-				Font.FontHeight = h = r - y;
+				font->Header.FontHeight = h = r - y;
 			}
 			else
 			{
@@ -186,34 +270,32 @@ void GrabFont (int xl, int yl, int firstchar)
 			}
 
 			// Determine glyph width
-			for (r = x+1; r < FontWidth; ++r)
-			{
-				if (FontBitmap[r+y*FontPitch] == FONT_BORDER)
-					break;
-			}
+			r = NextBorderInRow (font, x+1, y);
 
-			if (FontBitmap[r-1+(y-1)*FontPitch] != FONT_BORDER)
+			if (font->Bitmap[r-1+(y-1)*font->Pitch] != FONT_BORDER)
 			{ // If the top border was not present, skip to the next row
 				break;
 			}
 
-			if (Font.FontHeight != h)
+			if (font->Header.FontHeight != h)
 			{
-				fprintf (stderr, "Char #%d (%c) has height %d instead of %d\n",
-					glyph, glyph, h, Font.FontHeight);
+				char cname[CHARNAME_SIZE];
+				Eprintf ("Char %s has height %d instead of %d\n",
+					CharName (glyph, cname), h, font->Header.FontHeight);
 				return;
 			}
 
 			// Store glyph position and size
-			Chars[glyph].x = x;
-			Chars[glyph].y = y;
-			Chars[glyph].w = r-x;
+			if (!AddChar (font, glyph, x, y, r-x))
+			{
+				return;
+			}
 
 			glyph++;
 			x = r + 1;
 		}
 		// Advance to next row of image
-		y += Font.FontHeight + 1;
+		y += font->Header.FontHeight + 1;
 		x = xl;
 	}
 
@@ -221,188 +303,1027 @@ void GrabFont (int xl, int yl, int firstchar)
 
 	if (glyph >= firstchar)
 	{
-		if (firstchar < Font.FirstChar)
+		if (firstchar < font->FirstChar)
 		{
-			Font.FirstChar = firstchar;
+			font->FirstChar = firstchar;
 		}
-		if (glyph > Font.LastChar)
+		if (glyph > font->LastChar)
 		{
-			Font.LastChar = glyph;
+			font->LastChar = glyph;
 		}
 	}
 }
 
-bool EndFont (void)
+typedef struct
 {
-	BYTE *PackBytes;
-	FILE *f;
-	UWORD swizzle;
+	FontBuilder *Font;
+	int Spacing;
+	LONG *Cut;				// transparent pixels trimmed from each glyph
+} TrimJob;
+
+// Trims one glyph. Glyphs don't share columns, so they can be trimmed by
+// several threads at once.
+static void TrimGlyph (void *userdata, int job)
+{
+	TrimJob *trim = (TrimJob *)userdata;
+	FontBuilder *font = trim->Font;
+	UBYTE *glyph = font->Bitmap + font->Chars[job].x + font->Chars[job].y*font->Pitch;
+	int w = font->Chars[job].w;
+	int left = w, right = -1;
+	int x, y;
+
+	for (y = 0; y < font->Header.FontHeight; ++y)
+	{
+		UBYTE *row = glyph + y*font->Pitch;
+
+		for (x = 0; x < left; ++x)
+		{
+			if (row[x] != 0)
+			{
+				left = x;
+				break;
+			}
+		}
+		for (x = w - 1; x > right; --x)
+		{
+			if (row[x] != 0)
+			{
+				right = x;
+				break;
+			}
+		}
+	}
+	if (right < 0)
+	{
+		return;
+	}
+	w = right - left + 1 + trim->Spacing;
+	if (w > font->Chars[job].w - left)
+	{
+		w = font->Chars[job].w - left;
+	}
+	trim->Cut[job] = (LONG)(font->Chars[job].w - w) * font->Header.FontHeight;
+	font->Chars[job].x += left;
+	font->Chars[job].w = w;
+}
+
+// Cuts the transparent columns off both sides of every glyph, then gives
+// back up to spacing of the ones on the right, so that characters don't
+// touch when drawn. Glyphs with nothing in them, such as the space,
+// keep their width. Returns how many pixels were cut.
+static LONG TrimGlyphs (FontBuilder *font, int spacing)
+{
+	TrimJob trim;
+	LONG cut = 0;
 	int i;
-	int totalwidth;
 
-	if (Font.FirstChar > Font.LastChar)
+	trim.Font = font;
+	trim.Spacing = spacing;
+	trim.Cut = calloc (font->NumChars + 1, sizeof(LONG));
+	if (trim.Cut == NULL)
 	{
-		GrabFont (0, 0, ' ');
-		if (Font.FirstChar > Font.LastChar || Font.PaletteSize == 0)
+		Eprintf ("Out of memory\n");
+		return 0;
+	}
+	RunJobs (font->NumChars, TrimGlyph, &trim);
+	for (i = 0; i < font->NumChars; ++i)
+	{
+		cut += trim.Cut[i];
+	}
+	free (trim.Cut);
+	return cut;
+}
+
+typedef struct
+{
+	int x0, y0, x1, y1;
+} GlyphRow;
+
+// Returns the y of the bottom border of the box that spans columns x
+// through r-1, which is the first row where both sides hit a border.
+static int BoxBottom (FontBuilder *font, int x, int r, int y)
+{
+	int b1 = NextBorderInColumn (font, x, y);
+	int b2 = NextBorderInColumn (font, r-1, y);
+
+	while (b1 != b2)
+	{
+		if (b1 < b2)
+			b1 = NextBorderInColumn (font, x, b1+1);
+		else
+			b2 = NextBorderInColumn (font, r-1, b2+1);
+	}
+	return b1;
+}
+
+// Grabs a row of boxed glyphs, starting with the box whose top-left
+// interior pixel is (x,y). Columns left of minx already belong to another
+// row. Returns the x where the row ended.
+static int DetectGlyphRow (FontBuilder *font, int x, int y, int minx, int *glyph, GlyphRow *row)
+{
+	char cname[CHARNAME_SIZE];
+	int xl, r, b, h;
+
+	h = BoxBottom (font, x, NextBorderInRow (font, x, y), y) - y;
+	if (font->Header.FontHeight == 0)
+	{
+		font->Header.FontHeight = h;
+	}
+	b = y + h;
+	row->y0 = y;
+	row->y1 = b;
+
+	// Empty glyphs before the first box are extra border columns
+	for (xl = x - 1; xl > minx && b < font->Height &&
+		IS_BORDER(xl-1,y) && IS_BORDER(xl-1,y-1) && IS_BORDER(xl-1,b); xl--)
+		;
+	*glyph += x - 1 - xl;
+	row->x0 = xl;
+
+	while (x < font->Width && *glyph <= MAX_CODEPOINT)
+	{
+		if (IS_BORDER(x,y))
+		{ // An empty glyph, as long as it's still boxed in
+			if (b >= font->Height || !IS_BORDER(x,y-1) || !IS_BORDER(x,b))
+				break;
+			(*glyph)++;
+			x++;
+			continue;
+		}
+
+		r = NextBorderInRow (font, x, y);
+		if (r == font->Width)
+		{ // No box around this, so the row is done
+			break;
+		}
+		h = BoxBottom (font, x, r, y) - y;
+		if (!IS_BORDER(x,y-1) || !IS_BORDER(r-1,y-1))
+		{ // Only a glyph if the rest of the box is there
+			if (h != font->Header.FontHeight || y + h == font->Height || !IS_BORDER(r-1,y+h))
+				break;
+			Eprintf ("%s: Char %s at (%d,%d) is missing its top border\n",
+				font->Name, CharName (*glyph, cname), x, y);
+		}
+		if (h != font->Header.FontHeight)
 		{
-			fprintf (stderr, "%s: Nothing to save\n", FontName);
-			free (FontName);
-			return true;
+			Eprintf ("%s: Char %s at (%d,%d) has height %d instead of %d\n",
+				font->Name, CharName (*glyph, cname), x, y, h, font->Header.FontHeight);
+		}
+		else if (!AddChar (font, *glyph, x, y, r-x))
+		{
+			*glyph = MAX_CODEPOINT + 1;
+			break;
 		}
+		(*glyph)++;
+		x = r + 1;
 	}
+	row->x1 = x;
+	return x;
+}
 
-	f = fopen (FontName, "wb");
-	if (f == NULL)
+// Finds the glyph boxes without being told where they are. Every box
+// whose top and left borders meet at a corner starts a row of glyphs,
+// and the rows are numbered from firstchar in reading order. Anything
+// that looks like a box but isn't quite right is reported and skipped.
+static void DetectFontGrid (FontBuilder *font, int firstchar)
+{
+	GlyphRow *rows = NULL;
+	int numrows = 0, maxrows = 0;
+	int glyph = firstchar;
+	int x, y, i, minx;
+
+	for (y = 1; y < font->Height && glyph <= MAX_CODEPOINT; ++y)
 	{
-		fprintf (stderr, "Could not open %s\n", FontName);
-		free (FontName);
-		return true;
+		minx = 0;
+		for (x = NextBorderInRow (font, 0, y); x + 1 < font->Width && glyph <= MAX_CODEPOINT;
+			 x = NextBorderInRow (font, x, y))
+		{
+			if (IS_BORDER(x+1,y) || !IS_BORDER(x,y-1) || !IS_BORDER(x+1,y-1))
+			{
+				x++;
+				continue;
+			}
+			// Color 255 inside a glyph can look like a corner, too
+			for (i = 0; i < numrows; ++i)
+			{
+				if (x >= rows[i].x0 && x < rows[i].x1 && y > rows[i].y0 && y < rows[i].y1)
+					break;
+			}
+			if (i < numrows)
+			{
+				x = rows[i].x1;
+				continue;
+			}
+			if (numrows == maxrows)
+			{
+				GlyphRow *newrows;
+
+				maxrows = maxrows ? maxrows * 2 : 64;
+				newrows = realloc (rows, maxrows * sizeof(GlyphRow));
+				if (newrows == NULL)
+				{
+					Eprintf ("Out of memory\n");
+					free (rows);
+					return;
+				}
+				rows = newrows;
+			}
+			x = minx = DetectGlyphRow (font, x+1, y, minx, &glyph, &rows[numrows]);
+			numrows++;
+		}
+	}
+	free (rows);
+
+	if (glyph > MAX_CODEPOINT + 1)
+	{
+		Eprintf ("%s has glyphs out of range\n", font->Name);
+		glyph = MAX_CODEPOINT + 1;
+	}
+	glyph--;
+
+	if (glyph >= firstchar)
+	{
+		Printf ("%s: found %d glyphs in %d rows\n", font->Name, glyph - firstchar + 1, numrows);
+		if (firstchar < font->FirstChar)
+		{
+			font->FirstChar = firstchar;
+		}
+		if (glyph > font->LastChar)
+		{
+			font->LastChar = glyph;
+		}
+	}
+}
+
+// Adds a glyph to the table, which grows as needed.
+static bool AddChar (FontBuilder *font, int code, int x, int y, int w)
+{
+	if (font->NumChars == font->MaxChars)
+	{
+		int newmax = font->MaxChars ? font->MaxChars * 2 : 256;
+		CharRect *newchars = realloc (font->Chars, newmax * sizeof(CharRect));
+
+		if (newchars == NULL)
+		{
+			Eprintf ("Out of memory\n");
+			return false;
+		}
+		font->Chars = newchars;
+		font->MaxChars = newmax;
+	}
+	font->Chars[font->NumChars].Code = code;
+	font->Chars[font->NumChars].Order = font->NumChars;
+	font->Chars[font->NumChars].x = x;
+	font->Chars[font->NumChars].y = y;
+	font->Chars[font->NumChars].w = w;
+	font->NumChars++;
+	return true;
+}
+
+static int CompareChars (const void *arg1, const void *arg2)
+{
+	const CharRect *a = (const CharRect *)arg1;
+	const CharRect *b = (const CharRect *)arg2;
+
+	if (a->Code != b->Code)
+		return a->Code < b->Code ? -1 : 1;
+	return a->Order - b->Order;
+}
+
+// Formats a code point for messages. Characters on the first page are
+// shown the way they always were, and anything above as U+XXXX.
+static const char *CharName (int code, char name[CHARNAME_SIZE])
+{
+	if (code >= 0 && code <= 255)
+		snprintf (name, CHARNAME_SIZE, "#%d (%c)", code, code);
+	else
+		snprintf (name, CHARNAME_SIZE, "U+%04X", code);
+	return name;
+}
+
+// The glyph cache remembers how glyphs were packed, so that rebuilding a
+// font only has to pack the glyphs that changed. A glyph is known by
+// its size, two checksums of its pixels, and the color used in place of
+// 255, since those are everything that goes into packing it.
+typedef struct
+{
+	ULONG CRC, Adler;
+	UWORD Width, Height;
+	UBYTE Remap255, Pad[3];
+	ULONG PackedSize;		// the packed glyph follows in the cache file
+} CacheKey;
+
+typedef struct CachedGlyph
+{
+	CacheKey Key;
+	BYTE *Packed;
+} CachedGlyph;
+
+typedef struct
+{
+	FontBuilder *Font;
+	BYTE **Packed;			// one for each entry in Chars
+	int *PackedSize;
+	CacheKey *Keys;			// only when the cache is in use
+	bool *Reused;			// Packed belongs to the glyph cache
+} PackedGlyphs;
+
+static int CompareCacheKeys (const void *arg1, const void *arg2)
+{
+	const CacheKey *a = (const CacheKey *)arg1;
+	const CacheKey *b = (const CacheKey *)arg2;
+
+	if (a->CRC != b->CRC)
+		return a->CRC < b->CRC ? -1 : 1;
+	if (a->Adler != b->Adler)
+		return a->Adler < b->Adler ? -1 : 1;
+	if (a->Width != b->Width)
+		return a->Width - b->Width;
+	if (a->Height != b->Height)
+		return a->Height - b->Height;
+	return a->Remap255 - b->Remap255;
+}
+
+// Returns the name of the glyph cache for the current font.
+static char *GlyphCacheName (FontBuilder *font)
+{
+	char *name = malloc (strlen (font->Name) + 7);
+
+	if (name != NULL)
+	{
+		sprintf (name, "%s.cache", font->Name);
 	}
+	return name;
+}
+
+static void FreeGlyphCache (FontBuilder *font)
+{
+	int i;
 
-	PackBytes = malloc (FontWidth * FontHeight);
-	if (PackBytes == NULL)
+	for (i = 0; i < font->GlyphCacheSize; ++i)
+	{
+		free (font->GlyphCache[i].Packed);
+	}
+	free (font->GlyphCache);
+	font->GlyphCache = NULL;
+	font->GlyphCacheSize = 0;
+}
+
+// Reads the glyph cache, if there is one, and sorts it for searching.
+// A cache that can't be read is ignored, since it will be rewritten.
+static void LoadGlyphCache (FontBuilder *font)
+{
+	char *name = GlyphCacheName (font);
+	FILE *f;
+	ULONG id, count, i;
+
+	if (name == NULL)
+		return;
+	f = fopen (name, "rb");
+	free (name);
+	if (f == NULL)
+		return;
+
+	if (fread (&id, 4, 1, f) != 1 || id != ID_FGC3 ||
+		fread (&count, 4, 1, f) != 1)
+	{
+		fclose (f);
+		return;
+	}
+	count = LittleLong (count);
+	font->GlyphCache = calloc (count, sizeof(CachedGlyph));
+	if (font->GlyphCache == NULL)
 	{
-		fprintf (stderr, "Out of memory\n");
-		free (FontName);
 		fclose (f);
+		return;
+	}
+	for (i = 0; i < count; ++i)
+	{
+		CacheKey *key = &font->GlyphCache[i].Key;
+
+		if (fread (key, sizeof(CacheKey), 1, f) != 1)
+			break;
+		key->CRC = LittleLong (key->CRC);
+		key->Adler = LittleLong (key->Adler);
+		key->Width = LittleShort (key->Width);
+		key->Height = LittleShort (key->Height);
+		key->PackedSize = LittleLong (key->PackedSize);
+		if (key->PackedSize > (ULONG)MaxPackedSize (key->Width * key->Height))
+			break;
+		font->GlyphCache[i].Packed = malloc (key->PackedSize);
+		if (font->GlyphCache[i].Packed == NULL ||
+			fread (font->GlyphCache[i].Packed, 1, key->PackedSize, f) != key->PackedSize)
+		{
+			free (font->GlyphCache[i].Packed);
+			break;
+		}
+		font->GlyphCacheSize++;
+	}
+	fclose (f);
+	qsort (font->GlyphCache, font->GlyphCacheSize, sizeof(CachedGlyph), CompareCacheKeys);
+}
+
+// Replaces the glyph cache with the glyphs that were just packed.
+static void SaveGlyphCache (FontBuilder *font, PackedGlyphs *glyphs)
+{
+	char *name = GlyphCacheName (font);
+	FILE *f;
+	ULONG swap;
+	int i;
+
+	if (name == NULL)
+		return;
+	f = fopen (name, "wb");
+	if (f == NULL)
+	{
+		Eprintf ("Could not open %s\n", name);
+		free (name);
+		return;
+	}
+	free (name);
+
+	swap = ID_FGC3;
+	fwrite (&swap, 4, 1, f);
+	swap = LittleLong (font->NumChars);
+	fwrite (&swap, 4, 1, f);
+	for (i = 0; i < font->NumChars; ++i)
+	{
+		CacheKey key = glyphs->Keys[i];
+
+		key.CRC = LittleLong (key.CRC);
+		key.Adler = LittleLong (key.Adler);
+		key.Width = LittleShort (key.Width);
+		key.Height = LittleShort (key.Height);
+		key.PackedSize = LittleLong (glyphs->PackedSize[i]);
+		fwrite (&key, sizeof(key), 1, f);
+		fwrite (glyphs->Packed[i], 1, glyphs->PackedSize[i], f);
+	}
+	fclose (f);
+}
+
+// Packs one glyph into its own buffer, so that glyphs can be packed by
+// several threads at once. With the cache in use, the glyph is looked
+// up first and only packed if it isn't there.
+static void PackGlyph (void *userdata, int job)
+{
+	PackedGlyphs *glyphs = (PackedGlyphs *)userdata;
+	FontBuilder *font = glyphs->Font;
+	int w = font->Chars[job].w;
+	UBYTE *glyph = font->Bitmap + font->Chars[job].x + font->Chars[job].y*font->Pitch;
+	int y;
+
+	if (glyphs->Keys != NULL)
+	{
+		CacheKey *key = &glyphs->Keys[job];
+		CachedGlyph *hit;
+
+		key->CRC = 0;
+		key->Adler = 1;
+		for (y = 0; y < font->Header.FontHeight; ++y)
+		{
+			key->CRC = CRC32 (key->CRC, glyph + y*font->Pitch, w);
+			key->Adler = Adler32 (key->Adler, glyph + y*font->Pitch, w);
+		}
+		key->Width = w;
+		key->Height = font->Header.FontHeight;
+		key->Remap255 = font->Remap255;
+
+		hit = bsearch (key, font->GlyphCache, font->GlyphCacheSize, sizeof(CachedGlyph), CompareCacheKeys);
+		if (hit != NULL)
+		{ // The cache owns this, so it stays around until the font is written
+			glyphs->Packed[job] = hit->Packed;
+			glyphs->PackedSize[job] = hit->Key.PackedSize;
+			glyphs->Reused[job] = true;
+			return;
+		}
+	}
+
+	// Pack the glyph straight out of the image, with color 255 swapped
+	// for the closest color in the font.
+	glyphs->Packed[job] = malloc (MaxPackedSize (w * font->Header.FontHeight));
+	if (glyphs->Packed[job] == NULL)
+	{
+		return;
+	}
+	glyphs->PackedSize[job] = PackRect ((BYTE *)glyph, font->Pitch, w, font->Header.FontHeight,
+		(BYTE)255, (BYTE)font->Remap255, glyphs->Packed[job]);
+}
+
+// Writes the characters first through last, which must all be on the
+// same page of 256, to a FON2 file. Chars[start] through Chars[end-1]
+// are the glyphs in that range.
+static bool WriteFontPage (FontBuilder *font, const char *name, int first, int last,
+						   PackedGlyphs *glyphs, int start, int end)
+{
+	FILE *f;
+	UWORD swizzle;
+	int i, j;
+	int totalwidth;
+	bool failed;
+
+	ForgetPic (name);
+	f = fopen (name, "wb");
+	if (f == NULL)
+	{
+		Eprintf ("Could not open %s\n", name);
 		return true;
 	}
 
-	Font.bConstantWidth = 1;
+	font->Header.FirstChar = first & 255;
+	font->Header.LastChar = last & 255;
 
-	for (i = Font.FirstChar+1; i <= Font.LastChar; ++i)
+	// Empty characters have no glyph, so the width is only constant if
+	// every character has a glyph, or none of them do.
+	font->Header.bConstantWidth = (end == start);
+	if (end - start == last - first + 1)
 	{
-		if (Chars[Font.FirstChar].w != Chars[i].w)
+		font->Header.bConstantWidth = 1;
+		for (i = start+1; i < end; ++i)
 		{
-			Font.bConstantWidth = 0;
-			break;
+			if (font->Chars[start].w != font->Chars[i].w)
+			{
+				font->Header.bConstantWidth = 0;
+				break;
+			}
 		}
 	}
 
 	fwrite ("FON2", 4, 1, f);
-	swizzle = LittleShort (Font.FontHeight);
+	swizzle = LittleShort (font->Header.FontHeight);
 	fwrite (&swizzle, 2, 1, f);
-	fwrite (&Font.FirstChar, 1, 6, f);
-	if (Font.bConstantWidth)
+	fwrite (&font->Header.FirstChar, 1, 6, f);
+	if (font->Header.bConstantWidth)
 	{
-		swizzle = LittleShort (Chars[Font.FirstChar].w);
+		swizzle = LittleShort (end > start ? font->Chars[start].w : 0);
 		fwrite (&swizzle, 2, 1, f);
 	}
 	else
 	{
-		for (i = Font.FirstChar; i <= Font.LastChar; ++i)
+		for (i = first, j = start; i <= last; ++i)
 		{
-			swizzle = LittleShort (Chars[i].w);
+			if (j < end && font->Chars[j].Code == i)
+			{
+				swizzle = LittleShort (font->Chars[j].w);
+				j++;
+			}
+			else
+			{
+				swizzle = 0;
+			}
 			fwrite (&swizzle, 2, 1, f);
 		}
 	}
 
-	fwrite (FontPalette, 3, Font.PaletteSize, f);
+	fwrite (font->Palette, 3, font->Header.PaletteSize, f);
 
 	// Write out the color of the delimiter (color 255) so that the source
 	// image can be reconstructed with all used colors intact. This color
 	// is not included in the PaletteSize count in the header.
-	fwrite (FontPalette+255*3, 3, 1, f);
+	fwrite (font->Palette+255*3, 3, 1, f);
 
+	failed = false;
 	totalwidth = 0;
-	for (i = Font.FirstChar; i <= Font.LastChar; ++i)
+	for (i = start; i < end; ++i)
 	{
-		if (Chars[i].w)
+		if (glyphs->Packed[i] == NULL)
 		{
-			int y;
-			UBYTE *glyph = FontBitmap + Chars[i].x + Chars[i].y*FontPitch;
-			BYTE *pack_p = PackBytes;
-			
-			for (y = 0; y < Font.FontHeight; ++y)
-			{
-				int x;
-				for (x = 0; x < Chars[i].w; ++x)
-				{
-					pack_p[x] = glyph[x] != 255 ? glyph[x] : Font255Remap;
-				}
-				pack_p += Chars[i].w;
-				glyph += FontPitch;
-			}
-			pack_p = PackBytes;
-			packrow (&pack_p, f, Chars[i].w*y);
-			totalwidth += Chars[i].w;
+			failed = true;
+		}
+		else
+		{
+			fwrite (glyphs->Packed[i], 1, glyphs->PackedSize[i], f);
 		}
+		totalwidth += font->Chars[i].w;
 	}
 
-	printf ("%s: %d pixels of font glyphs stored\n", FontName, totalwidth * Font.FontHeight);
+	if (failed)
+	{
+		Eprintf ("Out of memory\n");
+	}
+	else
+	{
+		Printf ("%s: %d pixels of font glyphs stored\n", name, totalwidth * font->Header.FontHeight);
+	}
 
-	free (PackBytes);
-	free (FontName);
 	fclose (f);
+	return failed;
+}
 
-	return false;
+// Remembers that EndFont wrote a file, so FontFiles can say so. Takes
+// over the name, which must have come from malloc.
+static bool AddWrittenFile (FontBuilder *font, char *name)
+{
+	char **grown;
+
+	if (name == NULL)
+		return false;
+	grown = realloc (font->WrittenFiles, (font->NumWrittenFiles + 1) * sizeof(char *));
+	if (grown == NULL)
+	{
+		free (name);
+		return false;
+	}
+	font->WrittenFiles = grown;
+	font->WrittenFiles[font->NumWrittenFiles++] = name;
+	return true;
 }
 
-void SetFontShading (ShadeType shade)
+// Returns the names of the files EndFont wrote. They stay good until
+// the font is freed.
+char **FontFiles (FontBuilder *font, int *count)
 {
-	Font.ShadingType = shade;
+	*count = font->NumWrittenFiles;
+	return font->WrittenFiles;
 }
 
-static int compare (const void *arg1, const void *arg2)
+// Returns the file name for one page of a font that doesn't fit in
+// 256 characters. Page 4 of "big.fon" is "big_04.fon".
+static char *PageName (FontBuilder *font, int page)
 {
-	if (FontPalette[*((UBYTE *)arg1)*3  ] * 299 +
-		FontPalette[*((UBYTE *)arg1)*3+1] * 587 +
-		FontPalette[*((UBYTE *)arg1)*3+2] * 114  <
-		FontPalette[*((UBYTE *)arg2)*3  ] * 299 +
-		FontPalette[*((UBYTE *)arg2)*3+1] * 587 +
-		FontPalette[*((UBYTE *)arg2)*3+2] * 114)
-		return -1;
+	char *name = malloc (strlen (font->Name) + 8);
+	char *ext = strrchr (font->Name, '.');
+
+	if (name != NULL)
+	{
+		if (ext == NULL || strpbrk (ext, "/\\") != NULL)
+		{
+			ext = font->Name + strlen (font->Name);
+		}
+		sprintf (name, "%.*s_%02X%s", (int)(ext - font->Name), font->Name, page, ext);
+	}
+	return name;
+}
+
+bool EndFont (FontBuilder *font)
+{
+	PackedGlyphs glyphs;
+	int i, j;
+	LONG trimmed = 0;
+	bool failed;
+
+	if (font->FirstChar > font->LastChar)
+	{
+		DetectFontGrid (font, ' ');
+		if (font->FirstChar > font->LastChar || font->Header.PaletteSize == 0)
+		{
+			Eprintf ("%s: Nothing to save\n", font->Name);
+			free (font->ColumnBorders);
+			font->ColumnBorders = NULL;
+			return true;
+		}
+	}
+
+	// Grabbing is done, so the border map isn't needed anymore
+	free (font->ColumnBorders);
+	font->ColumnBorders = NULL;
+
+	// Sort the glyphs by code point, and only keep the last one grabbed
+	// for each.
+	qsort (font->Chars, font->NumChars, sizeof(CharRect), CompareChars);
+	for (i = j = 0; i < font->NumChars; ++i)
+	{
+		if (i + 1 == font->NumChars || font->Chars[i+1].Code != font->Chars[i].Code)
+		{
+			font->Chars[j++] = font->Chars[i];
+		}
+	}
+	font->NumChars = j;
+
+	if (font->TrimSpacing >= 0)
+	{
+		trimmed = TrimGlyphs (font, font->TrimSpacing);
+	}
+
+	glyphs.Font = font;
+	glyphs.Packed = calloc (font->NumChars + 1, sizeof(BYTE *));
+	glyphs.PackedSize = calloc (font->NumChars + 1, sizeof(int));
+	glyphs.Reused = calloc (font->NumChars + 1, sizeof(bool));
+	glyphs.Keys = font->CacheGlyphs ? calloc (font->NumChars + 1, sizeof(CacheKey)) : NULL;
+	if (glyphs.Packed == NULL || glyphs.PackedSize == NULL || glyphs.Reused == NULL ||
+		(font->CacheGlyphs && glyphs.Keys == NULL))
+	{
+		Eprintf ("Out of memory\n");
+		free (glyphs.Packed);
+		free (glyphs.PackedSize);
+		free (glyphs.Reused);
+		free (glyphs.Keys);
+		return true;
+	}
+
+	if (font->CacheGlyphs)
+	{
+		LoadGlyphCache (font);
+		// The CRC table must be built before the workers use it.
+		CRC32 (0, NULL, 0);
+	}
+
+	// Pack all the glyphs at once, then write them out in order.
+	RunJobs (font->NumChars, PackGlyph, &glyphs);
+
+	if (font->TrimSpacing >= 0)
+	{
+		LONG packed = 0;
+
+		for (i = 0; i < font->NumChars; ++i)
+		{
+			packed += glyphs.PackedSize[i];
+		}
+		Printf ("%s: trimmed %ld transparent pixels; the glyphs pack to %ld bytes\n",
+			font->Name, (long)trimmed, (long)packed);
+	}
+
+	if (font->LastChar <= 255)
+	{
+		failed = WriteFontPage (font, font->Name, font->FirstChar, font->LastChar, &glyphs, 0, font->NumChars);
+		if (!AddWrittenFile (font, strdup (font->Name)))
+		{
+			Eprintf ("Out of memory\n");
+			failed = true;
+		}
+	}
 	else
-		return 1;
+	{ // Too many characters for one FON2, so write one for each page
+	  // that has glyphs on it.
+		failed = false;
+		for (i = 0; i < font->NumChars; i = j)
+		{
+			int page = font->Chars[i].Code >> 8;
+			char *name = PageName (font, page);
+
+			for (j = i; j < font->NumChars && (font->Chars[j].Code >> 8) == page; ++j)
+				;
+			if (name == NULL)
+			{
+				Eprintf ("Out of memory\n");
+				failed = true;
+				break;
+			}
+			if (WriteFontPage (font, name, font->Chars[i].Code, font->Chars[j-1].Code, &glyphs, i, j))
+			{
+				failed = true;
+			}
+			if (!AddWrittenFile (font, name))
+			{
+				Eprintf ("Out of memory\n");
+				failed = true;
+				break;
+			}
+		}
+	}
+
+	if (font->CacheGlyphs)
+	{
+		if (!failed)
+		{
+			for (i = j = 0; i < font->NumChars; ++i)
+			{
+				j += glyphs.Reused[i];
+			}
+			Printf ("%s: %d of %d glyphs were already packed\n", font->Name, j, font->NumChars);
+			SaveGlyphCache (font, &glyphs);
+		}
+		FreeGlyphCache (font);
+	}
+
+	for (i = 0; i < font->NumChars; ++i)
+	{
+		if (!glyphs.Reused[i])
+			free (glyphs.Packed[i]);
+	}
+	free (glyphs.Packed);
+	free (glyphs.PackedSize);
+	free (glyphs.Reused);
+	free (glyphs.Keys);
+
+	return failed;
+}
+
+void SetFontShading (FontBuilder *font, ShadeType shade)
+{
+	font->Header.ShadingType = shade;
+}
+
+void FreeFont (FontBuilder *font)
+{
+	int i;
+
+	if (font == NULL)
+		return;
+	for (i = 0; i < font->NumWrittenFiles; ++i)
+	{
+		free (font->WrittenFiles[i]);
+	}
+	free (font->WrittenFiles);
+	FreeGlyphCache (font);
+	free (font->ColumnBorders);
+	free (font->Chars);
+	free (font->Name);
+	free (font);
+}
+
+// Sorts colors by increasing brightness with two passes of a radix sort
+// on their luma, which always fits in 18 bits. Colors that are equally
+// bright stay in the same order.
+static void SortByLuma (UBYTE *colors, int count, const UBYTE *palette)
+{
+	ULONG luma[256];
+	UBYTE sorted[256];
+	int pos[512];
+	int i, shift;
+
+	for (i = 0; i < 256; ++i)
+	{
+		luma[i] = palette[i*3] * 299 + palette[i*3+1] * 587 + palette[i*3+2] * 114;
+	}
+
+	for (shift = 0; shift < 18; shift += 9)
+	{
+		int total = 0;
+
+		memset (pos, 0, sizeof(pos));
+		for (i = 0; i < count; ++i)
+		{
+			pos[(luma[colors[i]] >> shift) & 511]++;
+		}
+		for (i = 0; i < 512; ++i)
+		{
+			int n = pos[i];
+			pos[i] = total;
+			total += n;
+		}
+		for (i = 0; i < count; ++i)
+		{
+			sorted[pos[(luma[colors[i]] >> shift) & 511]++] = colors[i];
+		}
+		memcpy (colors, sorted, count);
+	}
+}
+
+// Returns the x of the first border pixel in row y at or after x,
+// or the font's width if there isn't one.
+static int NextBorderInRow (FontBuilder *font, int x, int y)
+{
+	UBYTE *row = font->Bitmap + y*font->Pitch;
+	UBYTE *found;
+
+#ifdef USE_SSE2
+	__m128i border = _mm_set1_epi8 ((char)FONT_BORDER);
+
+	for (; x + 16 <= font->Width; x += 16)
+	{
+		int mask = _mm_movemask_epi8 (_mm_cmpeq_epi8 (
+			_mm_loadu_si128 ((__m128i *)(row + x)), border));
+		if (mask != 0)
+		{
+			while (!(mask & 1))
+			{
+				mask >>= 1;
+				x++;
+			}
+			return x;
+		}
+	}
+#endif
+	if (x >= font->Width)
+		return font->Width;
+	found = memchr (row + x, FONT_BORDER, font->Width - x);
+	return found != NULL ? found - row : font->Width;
+}
+
+// Returns the y of the first border pixel in column x at or after y,
+// or the font's height if there isn't one.
+static int NextBorderInColumn (FontBuilder *font, int x, int y)
+{
+	ULONG *words, bits;
+	int w;
+
+	if (y >= font->Height)
+		return font->Height;
+
+	if (font->ColumnBorders == NULL)
+	{
+		for (; y < font->Height; ++y)
+		{
+			if (font->Bitmap[x+y*font->Pitch] == FONT_BORDER)
+				break;
+		}
+		return y;
+	}
+
+	words = font->ColumnBorders + x*font->ColumnWords;
+	w = y >> 5;
+	bits = words[w] & (0xFFFFFFFF << (y & 31));
+	while (bits == 0)
+	{
+		if (++w == font->ColumnWords)
+			return font->Height;
+		bits = words[w];
+	}
+	for (y = w << 5; !(bits & 1); bits >>= 1)
+	{
+		y++;
+	}
+	return y;
+}
+
+static void AllocColumnBorders (FontBuilder *font)
+{
+	free (font->ColumnBorders);
+	font->ColumnWords = (font->Height + 31) >> 5;
+	font->ColumnBorders = calloc (font->Width * font->ColumnWords, sizeof(ULONG));
+	// If this fails, NextBorderInColumn can manage without it.
+}
+
+// Adds the border pixels in row y to the column border map.
+static void MarkRowBorders (FontBuilder *font, int y)
+{
+	int x;
+
+	if (font->ColumnBorders == NULL)
+		return;
+
+	for (x = NextBorderInRow (font, 0, y); x < font->Width; x = NextBorderInRow (font, x+1, y))
+	{
+		font->ColumnBorders[x*font->ColumnWords + (y>>5)] |= (ULONG)1 << (y & 31);
+	}
+}
+
+typedef struct
+{
+	UBYTE *Data;
+	int Pitch;
+	int CharWidth, CharHeight;
+	BYTE *Packed;			// each cell gets SlotSize bytes
+	int SlotSize;
+	int PackedSize[256];
+} ConFontCells;
+
+// Packs one cell straight out of the source image into its slot.
+static void PackConFontCell (void *userdata, int cell)
+{
+	ConFontCells *cells = (ConFontCells *)userdata;
+	int cw = cells->CharWidth, ch = cells->CharHeight;
+	UBYTE *src = cells->Data + (cell>>4)*ch*cells->Pitch + (cell&15)*cw;
+
+	cells->PackedSize[cell] = PackRect ((BYTE *)src, cells->Pitch, cw, ch, 0, 0,
+		cells->Packed + cell * cells->SlotSize);
 }
 
 int WriteConFont (const char *name, UBYTE *data, int width, int height, int srcwidth)
 {
+	ConFontCells cells;
+	BYTE *buffer, *buff_p;
 	int charwidth = srcwidth / 16;
 	int charheight = height / 16;
-	int x, y;
-	BYTE *shifted = malloc (srcwidth * height);
-	BYTE *shift_p;
+	int x;
 	FILE *f;
 
-	if (shifted == NULL)
+	if (charwidth == 0 || charheight == 0)
 	{
-		printf ("out of memory\n");
+		Printf ("%s is too small for a console font\n", name);
 		return 1;
 	}
 
-	shift_p = shifted;
+	// The header goes at the start of the buffer, followed by one slot
+	// for each cell big enough for the worst case.
+	cells.Data = data;
+	cells.Pitch = width;
+	cells.CharWidth = charwidth;
+	cells.CharHeight = charheight;
+	cells.SlotSize = MaxPackedSize (charwidth*charheight);
+	buffer = malloc (8 + 256 * cells.SlotSize);
+	if (buffer == NULL)
+	{
+		Printf ("out of memory\n");
+		return 1;
+	}
+	cells.Packed = buffer + 8;
+
+	RunJobs (256, PackConFontCell, &cells);
+
+	// Close up the gaps between the slots
+	buff_p = buffer + 8;
 	for (x = 0; x < 256; x++)
 	{
-		UBYTE *offset = data + (x>>4)*charheight*width + (x&15)*charwidth;
-		for (y = 0; y < charheight; y++)
-		{
-			memcpy (shift_p, offset, charwidth);
-			shift_p += charwidth;
-			offset += width;
-		}
+		memmove (buff_p, cells.Packed + x * cells.SlotSize, cells.PackedSize[x]);
+		buff_p += cells.PackedSize[x];
 	}
 
+	memcpy (buffer, "FON1", 4);
+	buffer[4] = charwidth & 255;
+	buffer[5] = charwidth >> 8;
+	buffer[6] = charheight & 255;
+	buffer[7] = charheight >> 8;
+
 	f = fopen (name, "wb");
 	if (f == NULL)
 	{
-		printf ("could not open %s\n", name);
+		Printf ("could not open %s\n", name);
+		free (buffer);
 		return 1;
 	}
-
-	fwrite ("FON1", 1, 4, f);
-	charwidth = LittleShort(charwidth);
-	fwrite (&charwidth, 2, 1, f);
-	charwidth = LittleShort(charwidth);
-	charheight = LittleShort(charheight);
-	fwrite (&charheight, 2, 1, f);
-	charheight = LittleShort(charheight);
-	shift_p = shifted;
-	for (x = 0; x < 256; x++)
-	{
-		packrow (&shift_p, f, charwidth*charheight);
-	}
+	fwrite (buffer, 1, buff_p - buffer, f);
 	fclose (f);
-	free (shifted);
+	free (buffer);
 	return 0;
 }
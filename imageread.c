@@ -35,9 +35,12 @@
 #include <stdio.h>
 #include <string.h>
 #include <malloc.h>
-#include <math.h>
+#include <ctype.h>
+#include <sys/types.h>
+#include <sys/stat.h>
 
 #include "afx.h"
+#include "threads.h"
 #include "ilbm.h"
 #include "pcx.h"
 #include "bmp.h"
@@ -49,6 +52,34 @@
 #define ID_FON2		MAKE_ID('F','O','N','2')
 #define ID_IMGZ		MAKE_ID('I','M','G','Z')
 
+#define PIC_HASH_SIZE		64
+#define DEFAULT_CACHE_MB	64
+
+// A decoded image that LoadPic can hand out again without rereading the
+// file, as long as the file's size and time stamp haven't changed.
+typedef struct CachedPic
+{
+	struct CachedPic *Newer, *Older;	// only while in the cache
+	struct CachedPic *HashNext;			// or the next evicted picture
+	char *Name;
+	long Size;
+	time_t MTime;
+	UBYTE Retrans;
+	bool Cached;			// once false, freed when Users reaches 0
+	int Users;				// LoadPic results not yet released
+	char *Messages;			// printed while decoding it
+	int MessagesLen;
+	UBYTE *Data;
+	int Width, Height, SrcWidth, CX, CY;
+	UBYTE Palette[768];
+} CachedPic;
+
+static CachedPic *PicHash[PIC_HASH_SIZE];
+static CachedPic *NewestPic, *OldestPic;
+static CachedPic *EvictedPics;
+static size_t PicCacheBytes, PicCacheLimit;
+static SpinLock PicLock;
+
 static const UBYTE DoomPalette[768] =
 {
 	  0,  0,  0, 31, 23, 11, 23, 15,  7, 75, 75, 75,255,255,255, 27, 27, 27,
@@ -114,12 +145,303 @@ static void LoadFON1 (FILE *file, char *filename, UBYTE **data, int *width, int
 static void LoadFON2 (FILE *file, char *filename, UBYTE **data, int *width, int *height,
 	int *srcwidth, int *cx, int *cy, UBYTE *palette);
 static int Unpack (FILE *file, const char *filename, UBYTE *dest, int destSize);
+static int UnpackRect (FILE *file, const char *filename, UBYTE *dest, int pitch, int w, int h);
+static int UnpackRLE8 (FILE *file, UBYTE *dest, int pitch, int height);
 
-static void SwapTrans (UBYTE *data, int width, int height);
+static void DecodePic (char *filename, UBYTE **data, int *width, int *height,
+	int *srcwidth, int *cx, int *cy, UBYTE *palette, UBYTE retrans);
+static void SwapTrans (UBYTE *data, int width, int height, UBYTE tcolor);
 static void BoxRow (UBYTE *dest, int j, int k, int y, int w);
+static int FON2Rows (const UWORD *widths, int first, int last, int w, int *used);
+static bool ReadFON2Widths (FILE *file, FontHeader *header, UWORD widths[256]);
+static void FON2Layout (const FontHeader *header, const UWORD *widths, int *w, int *h);
+
+// Turns on the cache of decoded images. IMAGETOOL_CACHE sets its size
+// in megabytes; 0 leaves it off.
+void EnablePicCache (void)
+{
+	char *env = getenv ("IMAGETOOL_CACHE");
+	int mb = env != NULL ? atoi (env) : DEFAULT_CACHE_MB;
+
+	PicCacheLimit = mb > 0 ? (size_t)mb << 20 : 0;
+}
+
+static unsigned int HashPicName (const char *name)
+{
+	unsigned int hash = 0;
+
+	while (*name)
+	{
+		hash = hash * 31 + tolower ((UBYTE)*name++);
+	}
+	return hash % PIC_HASH_SIZE;
+}
+
+static void FreeCachedPic (CachedPic *pic)
+{
+	free (pic->Messages);
+	free (pic->Data);
+	free (pic->Name);
+	free (pic);
+}
+
+// Takes a picture out of the cache. If anyone is still using it, it
+// waits on the evicted list until they're done. PicLock must be held.
+static void EvictPic (CachedPic *pic)
+{
+	CachedPic **prev = &PicHash[HashPicName (pic->Name)];
+
+	while (*prev != pic)
+		prev = &(*prev)->HashNext;
+	*prev = pic->HashNext;
+
+	if (pic->Newer) pic->Newer->Older = pic->Older; else NewestPic = pic->Older;
+	if (pic->Older) pic->Older->Newer = pic->Newer; else OldestPic = pic->Newer;
+
+	PicCacheBytes -= pic->Width * pic->Height;
+	pic->Cached = false;
+	if (pic->Users == 0)
+	{
+		FreeCachedPic (pic);
+	}
+	else
+	{
+		pic->HashNext = EvictedPics;
+		EvictedPics = pic;
+	}
+}
+
+// Finds the picture whose pixels LoadPic handed out as data, if any.
+// PicLock must be held.
+static CachedPic *FindPicUser (const UBYTE *data)
+{
+	CachedPic *pic;
+
+	for (pic = NewestPic; pic != NULL; pic = pic->Older)
+	{
+		if (pic->Data == data)
+			return pic;
+	}
+	for (pic = EvictedPics; pic != NULL; pic = pic->HashNext)
+	{
+		if (pic->Data == data)
+			return pic;
+	}
+	return NULL;
+}
+
+// Drops one user of a picture. PicLock must be held.
+static void DropPicUser (CachedPic *pic)
+{
+	if (--pic->Users == 0 && !pic->Cached)
+	{
+		CachedPic **prev = &EvictedPics;
+
+		while (*prev != pic)
+			prev = &(*prev)->HashNext;
+		*prev = pic->HashNext;
+		FreeCachedPic (pic);
+	}
+}
+
+// Frees image data returned by LoadPic.
+void ReleasePic (UBYTE *data)
+{
+	CachedPic *pic;
+
+	if (data == NULL)
+		return;
+
+	Lock (&PicLock);
+	pic = FindPicUser (data);
+	if (pic != NULL)
+	{
+		DropPicUser (pic);
+	}
+	Unlock (&PicLock);
+
+	if (pic == NULL)
+	{
+		free (data);
+	}
+}
+
+// Image data from LoadPic may be shared with the cache, so anything that
+// changes the pixels must call this first to get a copy of its own.
+void UnsharePic (UBYTE **data, int width, int height)
+{
+	CachedPic *pic;
+	UBYTE *copy;
+
+	if (*data == NULL)
+		return;
+
+	Lock (&PicLock);
+	pic = FindPicUser (*data);
+	Unlock (&PicLock);
+
+	if (pic == NULL)
+		return;
+
+	copy = malloc (width * height);
+	if (copy == NULL)
+	{
+		Eprintf ("Out of memory\n");
+		exit (20);
+	}
+	memcpy (copy, *data, width * height);
+	ReleasePic (*data);
+	*data = copy;
+}
+
+// Forgets any cached copy of a file that is about to be rewritten. A
+// quick rewrite can leave its size and time stamp unchanged.
+void ForgetPic (const char *filename)
+{
+	CachedPic *pic, *next;
+
+	Lock (&PicLock);
+	for (pic = PicHash[HashPicName (filename)]; pic != NULL; pic = next)
+	{
+		next = pic->HashNext;
+		if (stricmp (pic->Name, filename) == 0)
+			EvictPic (pic);
+	}
+	Unlock (&PicLock);
+}
+
+// Empties the cache. Pictures still in use are freed when released.
+void FlushPicCache (void)
+{
+	Lock (&PicLock);
+	while (NewestPic != NULL)
+	{
+		EvictPic (NewestPic);
+	}
+	Unlock (&PicLock);
+}
+
+// Looks for a cached copy of the file and hands it out if there is one.
+static bool FindCachedPic (const char *filename, const struct stat *st, UBYTE retrans,
+	UBYTE **data, int *width, int *height, int *srcwidth, int *cx, int *cy, UBYTE *palette)
+{
+	CachedPic *pic;
 
+	Lock (&PicLock);
+	for (pic = PicHash[HashPicName (filename)]; pic != NULL; pic = pic->HashNext)
+	{
+		if (pic->Retrans == retrans && stricmp (pic->Name, filename) == 0)
+			break;
+	}
+	if (pic != NULL && (pic->Size != (long)st->st_size || pic->MTime != st->st_mtime))
+	{
+		EvictPic (pic);
+		pic = NULL;
+	}
+	if (pic != NULL)
+	{
+		// Move it to the front of the list
+		if (pic->Newer != NULL)
+		{
+			pic->Newer->Older = pic->Older;
+			if (pic->Older) pic->Older->Newer = pic->Newer; else OldestPic = pic->Newer;
+			pic->Newer = NULL;
+			pic->Older = NewestPic;
+			NewestPic->Newer = pic;
+			NewestPic = pic;
+		}
+		pic->Users++;
+		*data = pic->Data;
+		*width = pic->Width;
+		*height = pic->Height;
+		*srcwidth = pic->SrcWidth;
+		*cx = pic->CX;
+		*cy = pic->CY;
+		memcpy (palette, pic->Palette, 768);
+	}
+	Unlock (&PicLock);
+
+	// Say the same things decoding it said, so the output doesn't depend
+	// on which load got to decode it.
+	if (pic != NULL)
+	{
+		ReplayLog (pic->Messages, pic->MessagesLen);
+	}
+	return pic != NULL;
+}
+
+// Adds a freshly decoded image to the cache, then throws out the least
+// recently used images until the cache fits in its limit again.
+static void CachePic (const char *filename, const struct stat *st, UBYTE retrans,
+	UBYTE *data, int width, int height, int srcwidth, int cx, int cy, UBYTE *palette,
+	int logmark)
+{
+	CachedPic *pic;
+	unsigned int hash;
+
+	if ((size_t)width * height > PicCacheLimit)
+		return;
+
+	pic = malloc (sizeof(CachedPic));
+	if (pic == NULL || (pic->Name = strdup (filename)) == NULL)
+	{
+		Eprintf ("Out of memory\n");
+		exit (20);
+	}
+	pic->Size = (long)st->st_size;
+	pic->MTime = st->st_mtime;
+	pic->Retrans = retrans;
+	pic->Cached = true;
+	pic->Users = 1;
+	pic->Messages = CopyLog (logmark, &pic->MessagesLen);
+	pic->Data = data;
+	pic->Width = width;
+	pic->Height = height;
+	pic->SrcWidth = srcwidth;
+	pic->CX = cx;
+	pic->CY = cy;
+	memcpy (pic->Palette, palette, 768);
+
+	hash = HashPicName (filename);
+	Lock (&PicLock);
+	pic->HashNext = PicHash[hash];
+	PicHash[hash] = pic;
+	pic->Newer = NULL;
+	pic->Older = NewestPic;
+	if (NewestPic) NewestPic->Newer = pic; else OldestPic = pic;
+	NewestPic = pic;
+	PicCacheBytes += width * height;
+	while (PicCacheBytes > PicCacheLimit)
+	{
+		EvictPic (OldestPic);
+	}
+	Unlock (&PicLock);
+}
+
+// Loads an image file. The data returned must be freed with ReleasePic,
+// and passed to UnsharePic before anything changes it.
 void LoadPic (char *filename, UBYTE **data, int *width, int *height,
-	int *srcwidth, int *cx, int *cy, UBYTE *palette)
+	int *srcwidth, int *cx, int *cy, UBYTE *palette, UBYTE retrans)
+{
+	struct stat st;
+	bool cacheable = PicCacheLimit != 0 && stat (filename, &st) == 0;
+	int logmark = LogMark ();
+
+	if (cacheable && FindCachedPic (filename, &st, retrans,
+		data, width, height, srcwidth, cx, cy, palette))
+	{
+		return;
+	}
+	DecodePic (filename, data, width, height, srcwidth, cx, cy, palette, retrans);
+	if (cacheable && *data != NULL)
+	{
+		CachePic (filename, &st, retrans, *data, *width, *height, *srcwidth, *cx, *cy,
+			palette, logmark);
+	}
+}
+
+static void DecodePic (char *filename, UBYTE **data, int *width, int *height,
+	int *srcwidth, int *cx, int *cy, UBYTE *palette, UBYTE retrans)
 {
 	int namelen = strlen (filename);
 
@@ -128,30 +450,134 @@ void LoadPic (char *filename, UBYTE **data, int *width, int *height,
 		if (stricmp (filename + namelen - 4, ".pcx") == 0)
 		{
 			LoadPCX (filename, data, width, height, srcwidth, cx, cy, palette);
-			SwapTrans (*data, *width, *height);
+			SwapTrans (*data, *width, *height, retrans);
 			return;
 		}
 		else if (stricmp (filename + namelen - 4, ".bmp") == 0)
 		{
 			LoadBMP (filename, data, width, height, srcwidth, cx, cy, palette);
-			SwapTrans (*data, *width, *height);
+			SwapTrans (*data, *width, *height, retrans);
 			return;
 		}
 	}
 	LoadID (filename, data, width, height, srcwidth, cx, cy, palette);
-	SwapTrans (*data, *width, *height);
+	SwapTrans (*data, *width, *height, retrans);
+}
+
+// Finds out what kind of image a file is and how big it is, reading no
+// more than its headers. Returns false if it can't tell.
+bool ProbePic (const char *filename, const char **format, int *width, int *height)
+{
+	int namelen = strlen (filename);
+	FILE *file = fopen (filename, "rb");
+	bool found = false;
+	ULONG id;
+
+	if (file == NULL)
+	{
+		return false;
+	}
+	if (namelen > 4 && stricmp (filename + namelen - 4, ".pcx") == 0)
+	{
+		pcxHeader header;
+
+		*format = "pcx";
+		if (fread (&header, sizeof(header), 1, file) == 1 && header.manufacturer == 10)
+		{
+			*width = LittleShort(header.xmax) - LittleShort(header.xmin) + 1;
+			*height = LittleShort(header.ymax) - LittleShort(header.ymin) + 1;
+			found = true;
+		}
+	}
+	else if (namelen > 4 && stricmp (filename + namelen - 4, ".bmp") == 0)
+	{
+		BitmapFileHeader fheader;
+		LONG size[3];
+
+		*format = "bmp";
+		if (fread (&fheader, sizeof(fheader), 1, file) == 1 &&
+			fheader.id[0] == 'B' && fheader.id[1] == 'M' &&
+			fread (size, 4, 3, file) == 3)
+		{
+			*width = LittleLong (size[1]);
+			*height = abs (LittleLong (size[2]));
+			found = true;
+		}
+	}
+	else if (fread (&id, 4, 1, file) == 1)
+	{
+		if (id == ID_FORM)
+		{
+			ULONG chunk[2];
+
+			*format = "ilbm";
+			fseek (file, 12, SEEK_SET);
+			while (fread (chunk, 4, 2, file) == 2 && chunk[0] != ID_BODY)
+			{
+				ULONG len = BigLong (chunk[1]);
+
+				if (chunk[0] == ID_BMHD)
+				{
+					UWORD size[2];
+
+					if (fread (size, 2, 2, file) == 2)
+					{
+						*width = BigShort (size[0]);
+						*height = BigShort (size[1]);
+						found = true;
+					}
+					break;
+				}
+				fseek (file, len + (len & 1), SEEK_CUR);
+			}
+		}
+		else if (id == ID_IMGZ || id == ID_FON1)
+		{
+			UWORD size[2];
+
+			*format = id == ID_IMGZ ? "imgz" : "fon1";
+			if (fread (size, 2, 2, file) == 2)
+			{
+				// FON1 has 256 characters, which get put in a 16 x 16 grid.
+				*width = LittleShort (size[0]) * (id == ID_FON1 ? 16 : 1);
+				*height = LittleShort (size[1]) * (id == ID_FON1 ? 16 : 1);
+				found = true;
+			}
+		}
+		else if (id == ID_FON2)
+		{
+			FontHeader header;
+			UWORD widths[256];
+
+			*format = "fon2";
+			if (ReadFON2Widths (file, &header, widths))
+			{
+				FON2Layout (&header, widths, width, height);
+				found = true;
+			}
+		}
+		else
+		{
+			// A patch starts with its size.
+			*format = "patch";
+			id = LittleLong (id);
+			*width = id & 0xffff;
+			*height = id >> 16;
+			found = *width > 0 && *height > 0;
+		}
+	}
+	fclose (file);
+	return found;
 }
 
-static void SwapTrans (UBYTE *data, int width, int height)
+// Swaps color 0 with tcolor, unless tcolor is 0.
+static void SwapTrans (UBYTE *data, int width, int height, UBYTE tcolor)
 {
 	int i;
-	UBYTE tcolor;
 
-	if (RetransImage == 0 || data == NULL)
+	if (tcolor == 0 || data == NULL)
 		return;
 
-	tcolor = RetransImage;
-
 	for (i = width*height; i != 0; --i)
 	{
 		if (*data == 0)
@@ -174,7 +600,7 @@ static void LoadID (char *filename, UBYTE **data, int *width, int *height,
 	file = fopen (filename, "rb");
 	if (file == NULL)
 	{
-		fprintf (stderr, "Could not open %s for reading\n", filename);
+		Eprintf ("Could not open %s for reading\n", filename);
 		return;
 	}
 	fread (&id, 4, 1, file);
@@ -217,7 +643,7 @@ static void LoadILBM (FILE *file, char *filename, UBYTE **data, int *width, int
 
 	if (temp1 != ID_ILBM)
 	{
-		fprintf (stderr, "%s is not an ILBM\n", filename);
+		Eprintf ("%s is not an ILBM\n", filename);
 		return;
 	}
 
@@ -231,13 +657,13 @@ static void LoadILBM (FILE *file, char *filename, UBYTE **data, int *width, int
 		curpos += 8;
 		temp2 = BigLong (temp2);
 
-		printf ("%c%c%c%c (%d bytes)\n",
+		Printf ("%c%c%c%c (%d bytes)\n",
 			temp1 & 255, (temp1 >> 8) & 255,
 			(temp1 >> 16) & 255, temp1 >> 24, temp2);
 
 		if (curpos + temp2 > filelen)
 		{
-			fprintf (stderr, "%s is incomplete (filelen: %d, pos: %d)\n", filename, filelen, curpos);
+			Eprintf ("%s is incomplete (filelen: %d, pos: %d)\n", filename, filelen, curpos);
 			return;
 		}
 
@@ -269,16 +695,16 @@ static void LoadILBM (FILE *file, char *filename, UBYTE **data, int *width, int
 			while (left >= MAXPLANEWIDTH)
 			{
 				fread (planes[0], MAXPLANEWIDTH, 1, file);
-				printf ("%s", planes[0]);
+				Printf ("%s", planes[0]);
 				left -= MAXPLANEWIDTH;
 			}
 			if (left > 0)
 			{
 				planes[0][left] = 0;
 				fread (planes[0], left, 1, file);
-				printf ("%s", planes[0]);
+				Printf ("%s", planes[0]);
 			}
-			printf ("\n");
+			Printf ("\n");
 			if (temp2 & 1)
 				fseek (file, 1, SEEK_CUR);
 		}
@@ -299,27 +725,27 @@ static void LoadILBM (FILE *file, char *filename, UBYTE **data, int *width, int
 
 	if (header.pad1 != 0)
 	{
-		fprintf (stderr, "BODY encountered before BMHD\n");
+		Eprintf ("BODY encountered before BMHD\n");
 		return;
 	}
 
 	if (header.compression > 1)
 	{
-		fprintf (stderr, "%s has unknown compression\n", filename);
+		Eprintf ("%s has unknown compression\n", filename);
 		return;
 	}
 
 	*srcwidth = header.w;
 	padwidth = (header.w + 15) & ~15;
 	planewidth = ((header.w + 15) / 16) * 2;
-	fprintf (stderr, "Dimensions: %d x %d\n", header.w, header.h);
+	Eprintf ("Dimensions: %d x %d\n", header.w, header.h);
 
 	*data = malloc (padwidth * header.h);
 	memset (*data, header.transparentColor, padwidth * header.h);
 
 	if (*data == NULL)
 	{
-		fprintf (stderr, "out of memory\n");
+		Eprintf ("out of memory\n");
 		return;
 	}
 
@@ -386,11 +812,8 @@ static void LoadILBM (FILE *file, char *filename, UBYTE **data, int *width, int
 
 	if (header.transparentColor)
 	{
-		UBYTE oldtrans = RetransImage;
 		UBYTE pal[3];
 
-		RetransImage = (UBYTE)header.transparentColor;
-		RetransImage = oldtrans;
 		pal[0] = palette[0];
 		pal[1] = palette[1];
 		pal[2] = palette[2];
@@ -420,20 +843,20 @@ static void LoadPCX (char *filename, UBYTE **data, int *width, int *height,
 	file = fopen (filename, "rb");
 	if (file == NULL)
 	{
-		fprintf (stderr, "Could not open %s for reading\n", filename);
+		Eprintf ("Could not open %s for reading\n", filename);
 		return;
 	}
 	if (fread (&header, sizeof(header), 1, file) != 1 ||
 		header.manufacturer != 10 ||
 		header.encoding != 1)
 	{
-		fprintf (stderr, "%s is not a pcx file\n", filename);
+		Eprintf ("%s is not a pcx file\n", filename);
 		fclose (file);
 		return;
 	}
 	if (header.version != 5 || header.bits_per_pixel != 8 || header.color_planes != 1)
 	{
-		fprintf (stderr, "%s is not 256-color\n", filename);
+		Eprintf ("%s is not 256-color\n", filename);
 		fclose (file);
 		return;
 	}
@@ -442,13 +865,13 @@ static void LoadPCX (char *filename, UBYTE **data, int *width, int *height,
 	*width = LittleShort(header.bytes_per_line);
 	*height = LittleShort(header.ymax) - LittleShort(header.ymin) + 1;
 	padwidth = *width;
-	fprintf (stderr, "Dimensions: %d x %d\n", *srcwidth, *height);
+	Eprintf ("Dimensions: %d x %d\n", *srcwidth, *height);
 
 	*data = malloc (padwidth * (*height));
 
 	if (*data == NULL)
 	{
-		fprintf (stderr, "out of memory\n");
+		Eprintf ("out of memory\n");
 		fclose (file);
 		return;
 	}
@@ -463,7 +886,7 @@ static void LoadPCX (char *filename, UBYTE **data, int *width, int *height,
 	{
 		if (fread (*data, padwidth * (*height), 1, file) != 1)
 		{
-			fprintf (stderr, "%s is corrupt\n", filename);
+			Eprintf ("%s is corrupt\n", filename);
 			fclose (file);
 			free (*data);
 			*data = NULL;
@@ -477,7 +900,7 @@ static void LoadPCX (char *filename, UBYTE **data, int *width, int *height,
 		{
 			if (fread (&c, 1, 1, file) != 1)
 			{
-				fprintf (stderr, "%s is corrupt\n", filename);
+				Eprintf ("%s is corrupt\n", filename);
 				fclose (file);
 				free (*data);
 				*data = NULL;
@@ -488,7 +911,7 @@ static void LoadPCX (char *filename, UBYTE **data, int *width, int *height,
 				run = c & 0x3f;
 				if (fread (&c, 1, 1, file) != 1)
 				{
-					fprintf (stderr, "%s is corrupt\n", filename);
+					Eprintf ("%s is corrupt\n", filename);
 					fclose (file);
 					free (*data);
 					*data = NULL;
@@ -504,7 +927,7 @@ static void LoadPCX (char *filename, UBYTE **data, int *width, int *height,
 		}
 		if (x > padwidth * *height)
 		{
-			fprintf (stderr, "eek! %d > %d\n", x, padwidth * (*height));
+			Eprintf ("eek! %d > %d\n", x, padwidth * (*height));
 			fclose (file);
 			free (*data);
 		}
@@ -548,20 +971,20 @@ static void LoadBMP (char *filename, UBYTE **data, int *width, int *height,
 	file = fopen (filename, "rb");
 	if (file == NULL)
 	{
-		fprintf (stderr, "Could not open %s for reading\n", filename);
+		Eprintf ("Could not open %s for reading\n", filename);
 		return;
 	}
 	if (fread (&fheader, sizeof(fheader), 1, file) != 1 ||
 		fheader.id[0] != 'B' ||
 		fheader.id[1] != 'M')
 	{
-		fprintf (stderr, "%s is not a bmp file\n", filename);
+		Eprintf ("%s is not a bmp file\n", filename);
 		fclose (file);
 		return;
 	}
 	if (fread (&isize, 4, 1, file) != 1)
 	{
-		fprintf (stderr, "%s is missing BITMAPINFOHEADER\n", filename);
+		Eprintf ("%s is missing BITMAPINFOHEADER\n", filename);
 		fclose (file);
 		return;
 	}
@@ -570,7 +993,7 @@ static void LoadBMP (char *filename, UBYTE **data, int *width, int *height,
 		sizeof(iheader)-4 > isize ? isize : sizeof(iheader)-4,
 		1, file) != 1)
 	{
-		fprintf (stderr, "%s is missing BITMAPINFOHEADER\n", filename);
+		Eprintf ("%s is missing BITMAPINFOHEADER\n", filename);
 		fclose (file);
 		return;
 	}
@@ -588,19 +1011,20 @@ static void LoadBMP (char *filename, UBYTE **data, int *width, int *height,
 
 	if (iheader.nPlanes != 1)
 	{
-		fprintf (stderr, "%s has %d planes (should be 1).\n", filename, iheader.nPlanes);
+		Eprintf ("%s has %d planes (should be 1).\n", filename, iheader.nPlanes);
 		fclose (file);
 		return;
 	}
 	if (iheader.bitCount != 8)
 	{
-		fprintf (stderr, "%s is not 8 bit.\n", filename);
+		Eprintf ("%s is not 8 bit.\n", filename);
 		fclose (file);
 		return;
 	}
-	if (iheader.compression != 0)
+	if (iheader.compression != BI_RGB &&
+		(iheader.compression != BI_RLE8 || (int)iheader.h < 0))
 	{
-		fprintf (stderr, "%s must be uncompressed.\n", filename);
+		Eprintf ("%s must be uncompressed or RLE8.\n", filename);
 		fclose (file);
 		return;
 	}
@@ -610,12 +1034,12 @@ static void LoadBMP (char *filename, UBYTE **data, int *width, int *height,
 	{
 		if (fread (palette + y*3, 1, 3, file) != 3)
 		{
-			fprintf (stderr, "%s has an incomplete palette.\n", filename);
+			Eprintf ("%s has an incomplete palette.\n", filename);
 			break;
 		}
 		if (fread (&c, 1, 1, file) != 1)
 		{
-			fprintf (stderr, "%s has an incomplete palette.\n", filename);
+			Eprintf ("%s has an incomplete palette.\n", filename);
 			break;
 		}
 	}
@@ -623,14 +1047,26 @@ static void LoadBMP (char *filename, UBYTE **data, int *width, int *height,
 	*srcwidth = iheader.w;
 	*height = abs (iheader.h);
 	*width = padwidth = (iheader.w+3) & (~3);
-	fprintf (stderr, "Dimensions: %d x %d\n", *srcwidth, *height);
+	Eprintf ("Dimensions: %d x %d\n", *srcwidth, *height);
 
 	*data = malloc (padwidth * (*height));
 	memset (*data, 0, padwidth * (*height));
 
 	if (*data == NULL)
 	{
-		fprintf (stderr, "out of memory\n");
+		Eprintf ("out of memory\n");
+		fclose (file);
+		return;
+	}
+
+	if (iheader.compression == BI_RLE8)
+	{
+		if (UnpackRLE8 (file, *data, padwidth, *height))
+		{
+			Eprintf ("%s is corrupt\n", filename);
+			free (*data);
+			*data = NULL;
+		}
 		fclose (file);
 		return;
 	}
@@ -650,7 +1086,7 @@ static void LoadBMP (char *filename, UBYTE **data, int *width, int *height,
 	{
 		if (fread (decodepos, padwidth, 1, file) != 1)
 		{
-			fprintf (stderr, "%s is corrupt\n", filename);
+			Eprintf ("%s is corrupt\n", filename);
 			fclose (file);
 			free (*data);
 			*data = NULL;
@@ -675,7 +1111,7 @@ static void LoadFON1 (FILE *file, char *filename, UBYTE **data, int *width, int
 
 	if (w == 0 || h == 0)
 	{
-		fprintf (stderr, "%s is not a valid console font\n", filename);
+		Eprintf ("%s is not a valid console font\n", filename);
 		return;
 	}
 
@@ -685,14 +1121,14 @@ static void LoadFON1 (FILE *file, char *filename, UBYTE **data, int *width, int
 	buff = malloc (w * h);
 	if (buff == NULL)
 	{
-		fprintf (stderr, "Out of memory\n");
+		Eprintf ("Out of memory\n");
 		return;
 	}
 
 	*data = malloc (w * h * 256);
 	if (*data == NULL)
 	{
-		fprintf (stderr, "Out of memory\n");
+		Eprintf ("Out of memory\n");
 		free (buff);
 		return;
 	}
@@ -739,123 +1175,174 @@ static void LoadFON1 (FILE *file, char *filename, UBYTE **data, int *width, int
 	}
 }
 
-static void LoadFON2 (FILE *file, char *filename, UBYTE **data, int *width, int *height,
-	int *srcwidth, int *cx, int *cy, UBYTE *palette)
+// Returns how many rows LoadFON2 needs to box the glyphs into an image
+// w pixels wide, and how wide the widest of those rows is.
+static int FON2Rows (const UWORD *widths, int first, int last, int w, int *used)
 {
-	FontHeader header;
-	UWORD widths[256];
-	int i, j, k, w, h, pixels, totalwidth, maxwidth;
-	UBYTE *buff;
+	int i, j, rows;
 
-	if (fread (&header.FontHeight, sizeof (header)-4, 1, file) != 1)
+	rows = 1;
+	j = 1;
+	*used = 1;
+	for (i = first; i <= last; ++i)
 	{
-		goto tooshort;
+		if (j + widths[i] + 1 > w)
+		{
+			j = 1;
+			rows++;
+		}
+		j += widths[i] + 1;
+		if (j > *used)
+		{
+			*used = j;
+		}
 	}
+	return rows;
+}
 
-	header.FontHeight = LittleShort (header.FontHeight);
+// Reads a FON2 header and its character widths, leaving the file at
+// the palette. Returns false if the file is too short.
+static bool ReadFON2Widths (FILE *file, FontHeader *header, UWORD widths[256])
+{
+	int i;
 
-	// Read character widths
-	memset (widths, 0, sizeof(widths));
-	if (header.bConstantWidth)
+	if (fread (&header->FontHeight, sizeof (*header)-4, 1, file) != 1)
+	{
+		return false;
+	}
+
+	header->FontHeight = LittleShort (header->FontHeight);
+
+	memset (widths, 0, 256 * sizeof(UWORD));
+	if (header->bConstantWidth)
 	{
 		UWORD width;
 
 		if (fread (&width, 2, 1, file) != 1)
 		{
-			goto tooshort;
+			return false;
 		}
 		width = LittleShort (width);
-		for (i = header.FirstChar; i <= header.LastChar; ++i)
+		for (i = header->FirstChar; i <= header->LastChar; ++i)
 		{
 			widths[i] = width;
 		}
-		totalwidth = (width + 1) * (header.LastChar - header.FirstChar + 1) + 1;
-		maxwidth = width;
 	}
 	else
 	{
-		size_t count = header.LastChar - header.FirstChar + 1;
-		if (fread (&widths[header.FirstChar], 2, count, file) != count)
+		size_t count = header->LastChar - header->FirstChar + 1;
+		if (fread (&widths[header->FirstChar], 2, count, file) != count)
 		{
-			goto tooshort;
+			return false;
 		}
-		totalwidth = 1;
-		maxwidth = 0;
-		for (i = header.FirstChar; i <= header.LastChar; ++i)
+		for (i = header->FirstChar; i <= header->LastChar; ++i)
 		{
 			widths[i] = LittleShort (widths[i]);
-			totalwidth += widths[i] + 1;
-			if (widths[i] > maxwidth)
-			{
-				maxwidth = widths[i];
-			}
 		}
 	}
+	return true;
+}
 
-	// Read palette
-	memset (palette, 0, 768);
-	if (fread (palette, 3, header.PaletteSize, file) != header.PaletteSize)
+// Finds the smallest image the glyphs can be boxed into. Glyphs must
+// stay in order for GrabFont, so for each possible number of rows,
+// find the narrowest width that fits them, and keep whichever of
+// those is smallest without being more than twice as wide as tall.
+static void FON2Layout (const FontHeader *header, const UWORD *widths, int *w, int *h)
+{
+	int i, rows, hi, pixels, totalwidth, maxwidth;
+	int best, bestw, besth;
+
+	totalwidth = 1;
+	maxwidth = 0;
+	for (i = header->FirstChar; i <= header->LastChar; ++i)
 	{
-		goto tooshort;
+		totalwidth += widths[i] + 1;
+		if (widths[i] > maxwidth)
+		{
+			maxwidth = widths[i];
+		}
 	}
-	if (fread (palette+255*3, 3, 1, file) != 1)
+
+	best = 0;
+	bestw = maxwidth + 3;
+	besth = header->FontHeight + 2;
+	hi = totalwidth;
+	for (rows = 1; rows <= header->LastChar - header->FirstChar + 1; ++rows)
 	{
-		goto tooshort;
+		int lo = maxwidth + 2, mid, used, height;
+
+		while (lo < hi)
+		{
+			mid = (lo + hi) / 2;
+			if (FON2Rows (widths, header->FirstChar, header->LastChar, mid, &used) <= rows)
+				hi = mid;
+			else
+				lo = mid + 1;
+		}
+		hi = lo;
+		if (FON2Rows (widths, header->FirstChar, header->LastChar, lo, &used) < rows)
+		{ // Doesn't need this many rows
+			continue;
+		}
+		// Leave a spare column so that no box line reaches the right edge.
+		// Otherwise, GrabFont can take the space after a short row for
+		// another glyph.
+		used++;
+		height = rows * (header->FontHeight + 1) + 1;
+		pixels = used * height;
+		if (best == 0 || bestw > 2*besth || (used <= 2*height && pixels < best))
+		{
+			best = pixels;
+			bestw = used;
+			besth = height;
+		}
 	}
+	*w = bestw;
+	*h = besth;
+}
 
-	// Determine a suitable image size
-	pixels = totalwidth * (header.FontHeight + 2);
-	w = (int)sqrt ((double)pixels);
-	if (w < maxwidth + 2) w = maxwidth + 2;
-	h = 1;
-	j = 1;
+static void LoadFON2 (FILE *file, char *filename, UBYTE **data, int *width, int *height,
+	int *srcwidth, int *cx, int *cy, UBYTE *palette)
+{
+	FontHeader header;
+	UWORD widths[256];
+	int i, j, k, w, h;
 
-	for (i = header.FirstChar; i <= header.LastChar; ++i)
+	if (!ReadFON2Widths (file, &header, widths))
 	{
-		if (j + widths[i] + 1 > w)
-		{
-			j = 1;
-			h++;
-		}
-		j += widths[i] + 1;
+		goto tooshort;
 	}
-	h = h * (header.FontHeight + 1) + 1;
-	fprintf (stderr, "Dimensions: %d x %d\n", w, h);
 
-	buff = malloc (maxwidth * header.FontHeight);
-	if (buff == NULL)
+	// Read palette
+	memset (palette, 0, 768);
+	if (fread (palette, 3, header.PaletteSize, file) != header.PaletteSize)
 	{
-		fprintf (stderr, "Out of memory\n");
-		return;
+		goto tooshort;
+	}
+	if (fread (palette+255*3, 3, 1, file) != 1)
+	{
+		goto tooshort;
 	}
 
+	FON2Layout (&header, widths, &w, &h);
+	Eprintf ("Dimensions: %d x %d\n", w, h);
+
 	*data = malloc (w * h);
 	if (*data == NULL)
 	{
-		free (buff);
-		fprintf (stderr, "Out of memory\n");
+		Eprintf ("Out of memory\n");
 		return;
 	}
 	memset (*data, 0, w * h);
 
+	// Unpack each glyph right where it goes in the image
 	j = 1;
 	k = 1;
 	for (i = header.FirstChar; i <= header.LastChar; ++i)
 	{
-		UBYTE *dest, *src;
+		UBYTE *dest;
 		int y;
 
-		if (widths[i])
-		{
-			if (Unpack (file, filename, buff, widths[i]*header.FontHeight))
-			{
-				free (buff);
-				free (*data);
-				*data = NULL;
-				return;
-			}
-		}
-
 		if (j + widths[i] + 1 > w)
 		{
 			BoxRow (*data, j, k, header.FontHeight, w);
@@ -863,20 +1350,24 @@ static void LoadFON2 (FILE *file, char *filename, UBYTE **data, int *width, int
 			k += header.FontHeight + 1;
 		}
 
-		src = buff;
 		dest = *data + k*w + j;
-		for (y = header.FontHeight; y > 0; --y)
+		for (y = 0; y < header.FontHeight; ++y)
 		{
-			*(dest - 1) = 255;
-			memcpy (dest, src, widths[i]);
-			dest += w;
-			src += widths[i];
+			dest[y*w - 1] = 255;
+		}
+		if (widths[i])
+		{
+			if (UnpackRect (file, filename, dest, w, widths[i], header.FontHeight))
+			{
+				free (*data);
+				*data = NULL;
+				return;
+			}
 		}
 		j += widths[i] + 1;
 	}
 
 	BoxRow (*data, j, k, header.FontHeight, w);
-	free (buff);
 
 	*width = *srcwidth = w;
 	*height = h;
@@ -884,7 +1375,7 @@ static void LoadFON2 (FILE *file, char *filename, UBYTE **data, int *width, int
 	return;
 
 tooshort:
-	fprintf (stderr, "%s is too short\n", filename);
+	Eprintf ("%s is too short\n", filename);
 	return;
 }
 
@@ -909,7 +1400,7 @@ static void LoadIMGZ (FILE *file, char *filename, UBYTE **data, int *width, int
 
 	if (fread (&header.Width, sizeof(header)-4, 1, file) != 1)
 	{
-		fprintf (stderr, "%s is too short\n", filename);
+		Eprintf ("%s is too short\n", filename);
 		return;
 	}
 
@@ -918,20 +1409,20 @@ static void LoadIMGZ (FILE *file, char *filename, UBYTE **data, int *width, int
 	header.LeftOffset = LittleShort (header.LeftOffset);
 	header.TopOffset = LittleShort (header.TopOffset);
 
-	fprintf (stderr, "Dimensions: %d x %d\nOrigin: (%d, %d)\n",
+	Eprintf ("Dimensions: %d x %d\nOrigin: (%d, %d)\n",
 		header.Width, header.Height,
 		header.LeftOffset, header.TopOffset);
 
 	if (header.Width == 0 || header.Height == 0)
 	{
-		fprintf (stderr, "%s has bad size\n", filename);
+		Eprintf ("%s has bad size\n", filename);
 		return;
 	}
 
 	*data = malloc (header.Width * header.Height);
 	if (*data == NULL)
 	{
-		fprintf (stderr, "Out of memory\n");
+		Eprintf ("Out of memory\n");
 	}
 
 	switch (header.Compression)
@@ -946,7 +1437,7 @@ static void LoadIMGZ (FILE *file, char *filename, UBYTE **data, int *width, int
 		break;
 
 	default:
-		fprintf (stderr, "%s has unknown compression %d\n", filename, header.Compression);
+		Eprintf ("%s has unknown compression %d\n", filename, header.Compression);
 		free (*data);
 		*data = NULL;
 		return;
@@ -954,7 +1445,7 @@ static void LoadIMGZ (FILE *file, char *filename, UBYTE **data, int *width, int
 
 	if (i != header.Width * header.Height)
 	{
-		fprintf (stderr, "Read %d bytes of pixel data. Wanted %d.\n", i,
+		Eprintf ("Read %d bytes of pixel data. Wanted %d.\n", i,
 			header.Width * header.Height);
 	}
 
@@ -987,7 +1478,7 @@ static void LoadPatch (FILE *file, char *filename, UBYTE **data, int *width, int
 	patch = malloc (patchSize);
 	if (patch == NULL)
 	{
-		fprintf (stderr, "out of memory\n");
+		Eprintf ("out of memory\n");
 		return;
 	}
 
@@ -995,7 +1486,7 @@ static void LoadPatch (FILE *file, char *filename, UBYTE **data, int *width, int
 
 	if ((size_t)x != patchSize)
 	{
-		fprintf (stderr, "only read %d bytes of %s\n", x, filename);
+		Eprintf ("only read %d bytes of %s\n", x, filename);
 		free (patch);
 		return;
 	}
@@ -1009,7 +1500,7 @@ static void LoadPatch (FILE *file, char *filename, UBYTE **data, int *width, int
 		if ((size_t)x*4+8 >= patchSize ||
 			(patch->ColumnOfs[x] = LittleLong(patch->ColumnOfs[x])) >= patchSize)
 		{
-			fprintf (stderr, "%s is not a Doom patch\n", filename);
+			Eprintf ("%s is not a Doom patch\n", filename);
 			free (patch);
 			return;
 		}
@@ -1020,12 +1511,12 @@ static void LoadPatch (FILE *file, char *filename, UBYTE **data, int *width, int
 	*srcwidth = patch->Width;
 	*width = patch->Width;
 	*height = patch->Height;
-	fprintf (stderr, "Dimensions: %d x %d\n", patch->Width, patch->Height);
+	Eprintf ("Dimensions: %d x %d\n", patch->Width, patch->Height);
 
 	*data = malloc (patch->Width * patch->Height);
 	if (*data == NULL)
 	{
-		fprintf (stderr, "out of memory\n");
+		Eprintf ("out of memory\n");
 		free (patch);
 		return;
 	}
@@ -1034,13 +1525,25 @@ static void LoadPatch (FILE *file, char *filename, UBYTE **data, int *width, int
 	for (x = 0; x < patch->Width; ++x)
 	{
 		DoomPost *column = (DoomPost *)((BYTE *)patch + patch->ColumnOfs[x]);
+		int top = -1;
 
 		while (column->TopDelta != 255)
 		{
 			int y = column->Length;
+			UBYTE *out, *in;
+
+			// Tall patches: a delta that is not past the previous post's
+			// top is relative to it.
+			if (column->TopDelta <= top)
+				top += column->TopDelta;
+			else
+				top = column->TopDelta;
 
-			UBYTE *out = *data + x + column->TopDelta*patch->Width;
-			UBYTE *in = (UBYTE *)column + 3;
+			if (top + y > patch->Height)
+				y = top < patch->Height ? patch->Height - top : 0;
+
+			out = *data + x + top*patch->Width;
+			in = (UBYTE *)column + 3;
 
 			while (y != 0)
 			{
@@ -1074,7 +1577,7 @@ static int Unpack (FILE *file, const char *filename, UBYTE *dest, int destSize)
 		if (code == EOF)
 		{
 eof:
-			fprintf (stderr, "%s is too short\n", filename);
+			Eprintf ("%s is too short\n", filename);
 			return destSize;
 		}
 		if (!(code & 0x80))
@@ -1108,3 +1611,122 @@ eof:
 
 	return destSize;
 }
+
+// Like Unpack, but the data fills a w x h rectangle inside an image
+// whose rows are pitch bytes apart. Returns non-zero if the data ran out
+// or didn't fit the rectangle.
+static int UnpackRect (FILE *file, const char *filename, UBYTE *dest, int pitch, int w, int h)
+{
+	int left = w * h;
+	int x = 0;
+
+	while (left > 0)
+	{
+		int code = fgetc (file);
+		if (code == EOF)
+		{
+eof:
+			Eprintf ("%s is too short\n", filename);
+			return 1;
+		}
+		if (!(code & 0x80))
+		{
+			int count = code+1;
+			if (count > left)
+			{
+				return 1;
+			}
+			left -= count;
+			while (count > 0)
+			{
+				code = fgetc (file);
+				if (code == EOF)
+				{
+					goto eof;
+				}
+				dest[x] = (UBYTE)code;
+				if (++x == w)
+				{
+					x = 0;
+					dest += pitch;
+				}
+				count--;
+			}
+		}
+		else if (code != 0x80)
+		{
+			int run = (256-code)+1;
+			if (run > left)
+			{
+				return 1;
+			}
+			left -= run;
+			code = fgetc (file);
+			if (code == EOF)
+			{
+				goto eof;
+			}
+			while (run > 0)
+			{
+				int span = w - x < run ? w - x : run;
+				memset (dest + x, code, span);
+				run -= span;
+				x += span;
+				if (x == w)
+				{
+					x = 0;
+					dest += pitch;
+				}
+			}
+		}
+	}
+	return 0;
+}
+
+// Decodes a bottom-up BI_RLE8 bitmap. Pixels skipped with the
+// end-of-line and delta codes are left alone. Returns non-zero if the
+// data ran out or tried to write outside the image.
+static int UnpackRLE8 (FILE *file, UBYTE *dest, int pitch, int height)
+{
+	int x = 0, y = height - 1;
+	int c1, c2;
+
+	for (;;)
+	{
+		if ((c1 = fgetc (file)) == EOF || (c2 = fgetc (file)) == EOF)
+			return 1;
+
+		if (c1 != 0)
+		{ // encoded run
+			if (y < 0 || x + c1 > pitch)
+				return 1;
+			memset (dest + y*pitch + x, c2, c1);
+			x += c1;
+		}
+		else if (c2 == 0)
+		{ // end of line
+			x = 0;
+			y--;
+		}
+		else if (c2 == 1)
+		{ // end of bitmap
+			return 0;
+		}
+		else if (c2 == 2)
+		{ // delta
+			if ((c1 = fgetc (file)) == EOF || (c2 = fgetc (file)) == EOF)
+				return 1;
+			x += c1;
+			y -= c2;
+		}
+		else
+		{ // absolute run
+			if (y < 0 || x + c2 > pitch ||
+				fread (dest + y*pitch + x, 1, c2, file) != (size_t)c2)
+				return 1;
+			x += c2;
+			if (c2 & 1)
+				fgetc (file);
+		}
+	}
+}
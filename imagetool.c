@@ -32,9 +32,10 @@
 */
 
 #include "afx.h"
-
-extern FILE *yyin;
-extern int yyparse (void);
+#include "deflate.h"
+#include "script.h"
+#include "server.h"
+#include "files.h"
 
 enum
 {
@@ -44,14 +45,16 @@ enum
 	MODE_Font,
 	MODE_PCX,
 	MODE_BMP,
+	MODE_RLEBMP,
 	MODE_ILBM,
+	MODE_Patch,
+	MODE_PNG,
 };
 
-UBYTE RetransImage = 0;
-
 void usage (void)
 {
-	printf ("Usage: imagetool [-0] <type> <source> <output>\n"
+	printf ("Usage: imagetool [-0] [-a] [-c] [-t#] [-z#] [-MD] [-MF <file>] [-MT <target>]\n"
+			"                 <type> <source> <output>\n"
 			"<type> can be:\n"
 			"\tconfont : Monospaced console font\n"
 			"\tfont    : Normal font\n"
@@ -59,17 +62,78 @@ void usage (void)
 			"\txhair   : Crosshair\n"
 			"\tpcx     : Convert <source> to a PCX file\n"
 			"\tbmp     : Convert <source> to a BMP file\n"
+			"\trlebmp  : Convert <source> to an RLE8-compressed BMP file\n"
 			"\tilbm    : Convert <source> to an ILBM file\n"
+			"\tpatch   : Convert <source> to a Doom patch\n"
+			"\tpng     : Convert <source> to a paletted PNG file\n"
 			"<source> can be an ILBM, BMP, PCX, IMGZ, FON1, FON2, or Doom patch.\n"
-			"Specify -0 to swap colors 0 and 247 in <source>.\n\n"
+			"Specify -0 to swap colors 0 and 247 in <source>.\n"
+			"Specify -c to keep a cache of packed glyphs beside each font,\n"
+			"so that rebuilding it only packs the glyphs that changed.\n"
+			"Specify -t# to trim the transparent columns from the sides of\n"
+			"font glyphs, leaving # columns of space on the right. Plain -t\n"
+			"leaves one.\n"
+			"Specify -z1 (fastest) through -z9 (smallest) to set the PNG\n"
+			"compression effort. The default is -z%d.\n"
+			"Specify -MD to write a make dependency file listing the files\n"
+			"that were read and written, named after <output> or the first\n"
+			"script. -MF <file> names it instead. -MT <target> makes it\n"
+			"name only <target> as being built, which is what ninja wants.\n\n"
 			"Alternatively, to process a script file, in place of <type>, use:\n"
-			"\timagetool script <file>\n"
-			);
+			"\timagetool script [--watch | --plan] <file> [<file> ...]\n"
+			"Several scripts are run together, sharing the work between threads.\n"
+			"A script only rebuilds outputs whose sources or commands have\n"
+			"changed since the last run. Specify -a to rebuild all of them.\n"
+			"With --watch, the scripts are run again whenever a file they\n"
+			"read changes. With --plan, they aren't run; instead, what they\n"
+			"would read and write and about how long it would take is shown.\n\n"
+			"To keep running and take commands from other programs, use:\n"
+			"\timagetool serve --socket <path>\n",
+			DEFLATE_DEFAULT);
 	exit (10);
 }
 
-int main (int argc, char **argv)
+// Writes the dependency file for one command, which built the outputs
+// from source. If the command failed, an old dependency file is removed
+// instead, since it describes a build that isn't there anymore.
+static int WriteCommandDeps (const Options *options, const char *output, char *source,
+	char **outputs, int numoutputs, int failed)
 {
+	char *depname = options->DepFile;
+
+	if (depname == NULL)
+	{
+		depname = malloc (strlen (output) + 3);
+		if (depname == NULL)
+		{
+			fprintf (stderr, "Out of memory\n");
+			exit (20);
+		}
+		strcpy (depname, output);
+		strcat (depname, ".d");
+	}
+	if (failed)
+	{
+		remove (depname);
+	}
+	else
+	{
+		failed = WriteDepFile (depname, options->DepTarget, outputs, numoutputs, &source, 1) ? 20 : 0;
+	}
+	if (depname != options->DepFile)
+	{
+		free (depname);
+	}
+	return failed;
+}
+
+// Does what one command line asks for. Returns BAD_USAGE if it doesn't
+// make sense, or else the exit code. A server sets served, since it has
+// already set up the cache and can't wait forever on one command.
+int RunCommand (int argc, char **argv, int served)
+{
+	Options options;
+	FontBuilder *font;
 	UBYTE palette[768];
 	int width, height, srcwidth;
 	UBYTE *data;
@@ -77,21 +141,53 @@ int main (int argc, char **argv)
 	int failed;
 	int cx, cy;
 	int argstart;
+	char **outputs;
+	int numoutputs;
 
 	if (argc < 3)
 	{
-		usage ();
+		return BAD_USAGE;
 	}
 
-	if (argv[1][0] == '-')
+	memset (&options, 0, sizeof(options));
+	options.TrimSpacing = -1;
+	options.PNGLevel = DEFLATE_DEFAULT;
+
+	for (argstart = 1; argstart < argc && argv[argstart][0] == '-'; ++argstart)
 	{
-		if (argv[1][1] == '0')
-			RetransImage = 247;
-		argstart = 2;
+		if (argv[argstart][1] == '0')
+			options.Retrans = 247;
+		else if (argv[argstart][1] == 'a')
+			options.RebuildAll = true;
+		else if (argv[argstart][1] == 'c')
+			options.FontCache = true;
+		else if (argv[argstart][1] == 't')
+			options.TrimSpacing = argv[argstart][2] ? atoi (argv[argstart]+2) : 1;
+		else if (argv[argstart][1] == 'z' &&
+			argv[argstart][2] >= '1' && argv[argstart][2] <= '9')
+			options.PNGLevel = argv[argstart][2] - '0';
+		else if (strcmp (argv[argstart], "-MD") == 0)
+			options.WriteDeps = true;
+		else if (strncmp (argv[argstart], "-MF", 3) == 0 ||
+			strncmp (argv[argstart], "-MT", 3) == 0)
+		{
+			char **setting = argv[argstart][2] == 'F' ? &options.DepFile : &options.DepTarget;
+
+			// The value can be in the same argument or the next one.
+			if (argv[argstart][3] != 0)
+				*setting = argv[argstart] + 3;
+			else if (++argstart < argc)
+				*setting = argv[argstart];
+			else
+				return BAD_USAGE;
+			options.WriteDeps = true;
+		}
+		else
+			return BAD_USAGE;
 	}
-	else
+	if (argstart >= argc)
 	{
-		argstart = 1;
+		return BAD_USAGE;
 	}
 
 	if (stricmp (argv[argstart], "confont") == 0)
@@ -112,17 +208,35 @@ int main (int argc, char **argv)
 	}
 	else if (stricmp (argv[argstart], "script") == 0)
 	{
+		bool watch = argc - argstart >= 2 && strcmp (argv[argstart+1], "--watch") == 0;
+		bool plan = argc - argstart >= 2 && strcmp (argv[argstart+1], "--plan") == 0;
+
+		if (watch || plan)
+		{
+			argstart++;
+		}
 		if (argc - argstart < 2)
 		{
-			usage ();
+			return BAD_USAGE;
+		}
+		if (plan)
+		{
+			return PlanScripts (&options, argc - argstart - 1, argv + argstart + 1);
+		}
+		if (watch && served)
+		{
+			Eprintf ("script --watch never finishes, so a server can't run it\n");
+			return 10;
+		}
+		if (!served)
+		{
+			EnablePicCache ();
 		}
-		yyin = fopen (argv[argstart+1], "r");
-		if (yyin == NULL)
+		if (watch)
 		{
-			fprintf (stderr, "Could not open %s\n", argv[argstart+1]);
-			return 20;
+			return WatchScripts (&options, argc - argstart - 1, argv + argstart + 1);
 		}
-		return yyparse ();
+		return RunScripts (&options, argc - argstart - 1, argv + argstart + 1);
 	}
 	else if (stricmp (argv[argstart], "pcx") == 0)
 	{
@@ -132,24 +246,43 @@ int main (int argc, char **argv)
 	{
 		mode = MODE_BMP;
 	}
+	else if (stricmp (argv[argstart], "rlebmp") == 0)
+	{
+		mode = MODE_RLEBMP;
+	}
 	else if (stricmp (argv[argstart], "ilbm") == 0)
 	{
 		mode = MODE_ILBM;
 	}
+	else if (stricmp (argv[argstart], "patch") == 0)
+	{
+		mode = MODE_Patch;
+	}
+	else if (stricmp (argv[argstart], "png") == 0)
+	{
+		mode = MODE_PNG;
+	}
 	else
 	{
-		usage ();
+		return BAD_USAGE;
 	}
 
 	if (argc - argstart < 3)
 	{
-		usage ();
+		return BAD_USAGE;
 	}
 
-	LoadPic (argv[argstart+1], &data, &width, &height, &srcwidth, &cx, &cy, palette);
+	LoadPic (argv[argstart+1], &data, &width, &height, &srcwidth, &cx, &cy, palette,
+		options.Retrans);
 	if (data == NULL)
+	{
+		if (options.WriteDeps)
+			WriteCommandDeps (&options, argv[argstart+2], argv[argstart+1], NULL, 0, 20);
 		return 20;
+	}
 
+	ForgetPic (argv[argstart+2]);
+	font = NULL;
 	switch (mode)
 	{
 	case MODE_ConFont:
@@ -157,8 +290,9 @@ int main (int argc, char **argv)
 		break;
 
 	case MODE_Font:
-		StartFont (argv[argstart+2], data, width, height, srcwidth, palette);
-		failed = EndFont ();
+		UnsharePic (&data, width, height);
+		font = StartFont (argv[argstart+2], data, width, height, srcwidth, palette, &options);
+		failed = font == NULL || EndFont (font);
 		break;
 
 	case MODE_Crosshair:
@@ -182,15 +316,66 @@ int main (int argc, char **argv)
 		break;
 
 	case MODE_BMP:
-		failed = WriteBMPfile (argv[argstart+2], data, width, height, srcwidth, palette);
+		failed = WriteBMPfile (argv[argstart+2], data, width, height, srcwidth, palette, false);
+		break;
+
+	case MODE_RLEBMP:
+		failed = WriteBMPfile (argv[argstart+2], data, width, height, srcwidth, palette, true);
 		break;
 
 	case MODE_ILBM:
 		failed = WriteILBMfile (argv[argstart+2], data, width, height, srcwidth, cx, cy, palette);
 		break;
+
+	case MODE_Patch:
+		if (cx == 0x8000)
+		{
+			cx = 0;
+			cy = 0;
+		}
+		failed = WritePatchfile (argv[argstart+2], data, width, height, srcwidth, cx, cy);
+		break;
+
+	case MODE_PNG:
+		failed = WritePNGfile (argv[argstart+2], data, width, height, srcwidth, cx, cy, palette, options.PNGLevel);
+		break;
 	}
 
-	free (data);
+	ReleasePic (data);
+
+	if (options.WriteDeps)
+	{
+		// A font with more than 256 characters is written as pages, and
+		// the name on the command line is never made.
+		outputs = &argv[argstart+2];
+		numoutputs = 1;
+		if (font != NULL)
+		{
+			outputs = FontFiles (font, &numoutputs);
+		}
+		failed = WriteCommandDeps (&options, argv[argstart+2], argv[argstart+1], outputs, numoutputs, failed);
+	}
+	FreeFont (font);
 
 	return failed;
 }
+
+int main (int argc, char **argv)
+{
+	int result;
+
+	if (argc == 4 && stricmp (argv[1], "serve") == 0 && strcmp (argv[2], "--socket") == 0)
+	{
+		// Requests run at the same time, so build the tables they share
+		// before there is more than one thread.
+		EnablePicCache ();
+		CRC32 (0, NULL, 0);
+		return Serve (argv[3]);
+	}
+	result = RunCommand (argc, argv, 0);
+	if (result == BAD_USAGE)
+	{
+		usage ();
+	}
+	return result;
+}
@@ -66,7 +66,7 @@ LINK32=link.exe
 # PROP Intermediate_Dir "Debug"
 # PROP Target_Dir ""
 # ADD BASE CPP /nologo /W3 /Gm /GX /ZI /Od /D "WIN32" /D "_DEBUG" /D "_CONSOLE" /D "_MBCS" /YX /FD /GZ /c
-# ADD CPP /nologo /W3 /Gm /GX /ZI /Od /D "WIN32" /D "_DEBUG" /D "_CONSOLE" /D "_MBCS" /YX /FD /GZ /c
+# ADD CPP /nologo /MDd /W3 /Gm /GX /ZI /Od /D "WIN32" /D "_DEBUG" /D "_CONSOLE" /D "_MBCS" /YX /FD /GZ /c
 # ADD BASE RSC /l 0x409 /d "_DEBUG"
 # ADD RSC /l 0x409 /d "_DEBUG"
 BSC32=bscmake.exe
@@ -87,6 +87,14 @@ LINK32=link.exe
 # PROP Default_Filter "cpp;c;cxx;rc;def;r;odl;idl;hpj;bat"
 # Begin Source File
 
+SOURCE=.\deflate.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\files.c
+# End Source File
+# Begin Source File
+
 SOURCE=.\font.c
 # End Source File
 # Begin Source File
@@ -107,8 +115,24 @@ SOURCE=.\makeimage.c
 # End Source File
 # Begin Source File
 
+SOURCE=.\output.c
+# End Source File
+# Begin Source File
+
 SOURCE=.\packer.c
 # End Source File
+# Begin Source File
+
+SOURCE=.\script.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\server.c
+# End Source File
+# Begin Source File
+
+SOURCE=.\threads.c
+# End Source File
 # End Group
 # Begin Group "Header Files"
 
@@ -123,10 +147,22 @@ SOURCE=.\bmp.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\deflate.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\files.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\ilbm.h
 # End Source File
 # Begin Source File
 
+SOURCE=.\output.h
+# End Source File
+# Begin Source File
+
 SOURCE=.\packer.h
 # End Source File
 # Begin Source File
@@ -137,6 +173,18 @@ SOURCE=.\patch.h
 
 SOURCE=.\pcx.h
 # End Source File
+# Begin Source File
+
+SOURCE=.\script.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\server.h
+# End Source File
+# Begin Source File
+
+SOURCE=.\threads.h
+# End Source File
 # End Group
 # Begin Group "Generated Source Files"
 
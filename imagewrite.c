@@ -1,6 +1,6 @@
 /*
 ** imagewrite.c
-** Routines for writing ILBM, PCX and BMP.
+** Routines for writing ILBM, PCX, BMP, PNG and Doom patches.
 **
 **---------------------------------------------------------------------------
 ** Copyright 2001 Randy Heit
@@ -35,26 +35,85 @@
 #include "pcx.h"
 #include "bmp.h"
 #include "ilbm.h"
+#include "patch.h"
+#include "deflate.h"
+#include "threads.h"
+
+#ifdef USE_SSE2
+#include <emmintrin.h>
+#endif
 
 #define MAXPLANEWIDTH		(1600/8)
 
 static const char Anno[] = "Created with the ZDoom imagetool.";
 
-static void c2p (UBYTE *planes, int planewidth, UBYTE *src, int width);
+static void c2p (UBYTE *planes, int stride, int planewidth, UBYTE *src, int width);
+static void c2p8 (UBYTE *planes, int planewidth, UBYTE *src);
+#ifdef USE_SSE2
+static void c2p16 (UBYTE *planes, int planewidth, UBYTE *src);
+#endif
+#ifdef _DEBUG
+static void TestILBM (void);
+#endif
+
+typedef struct
+{
+	UBYTE *Data;
+	int Pitch, Width, Height;
+	int BandHeight;
+	UBYTE *Packed;			// one buffer, each band gets BandSize bytes of it
+	int BandSize;
+	int *PackedSize;		// number of bytes actually used by each band
+} PCXBands;
+
+static int PackPCXRow (UBYTE *dest, UBYTE *data, int width);
+static void PackPCXBand (void *userdata, int band);
+static int PackRLE8Row (UBYTE *dest, UBYTE *src, int width);
+static int PackPatchColumn (UBYTE *dest, UBYTE *src, int pitch, int height);
+static void FilterPNGRow (UBYTE *dest, UBYTE *row, UBYTE *prev, int width, int level);
+static void WritePNGChunk (FILE *file, const char *id, UBYTE *data, int len);
 
 int WritePCXfile (const char *filename, UBYTE *data, int pitch, int height,
 	int width, UBYTE *palette)
 {
-	int x, y;
-	int runlen;
-	UBYTE color;
+	PCXBands bands;
+	int numbands, i;
 	pcxHeader pcx;
 	FILE *file;
 
+	// Each band of rows is packed into its own part of one big buffer.
+	// PCX runs never cross scanlines, so the bands can be packed
+	// independently and then written out one after the other.
+	bands.Data = data;
+	bands.Pitch = pitch;
+	bands.Width = width;
+	bands.Height = height;
+	numbands = NumWorkers () * 4;
+	if (numbands > height)
+		numbands = height;
+	if (numbands < 1)
+		numbands = 1;
+	bands.BandHeight = (height + numbands - 1) / numbands;
+	if (bands.BandHeight < 1)
+		bands.BandHeight = 1;
+	numbands = (height + bands.BandHeight - 1) / bands.BandHeight;
+	bands.BandSize = bands.BandHeight * (width * 2 + 1);
+	bands.Packed = malloc (numbands * bands.BandSize);
+	bands.PackedSize = malloc (numbands * sizeof(int));
+	if (bands.Packed == NULL || bands.PackedSize == NULL)
+	{
+		Eprintf ("Out of memory\n");
+		free (bands.Packed);
+		free (bands.PackedSize);
+		return 1;
+	}
+
 	file = fopen (filename, "wb");
 	if (file == NULL)
 	{
-		fprintf (stderr, "Could not open %s\n", filename);
+		Eprintf ("Could not open %s\n", filename);
+		free (bands.Packed);
+		free (bands.PackedSize);
 		return 1;
 	}
 
@@ -78,136 +137,264 @@ int WritePCXfile (const char *filename, UBYTE *data, int pitch, int height,
 	fwrite (&pcx, 128, 1, file);
 
 	// pack the image
-	for (y = height; y > 0; y--)
+	RunJobs (numbands, PackPCXBand, &bands);
+	for (i = 0; i < numbands; ++i)
 	{
-		color = *data++;
-		runlen = 1;
+		fwrite (bands.Packed + i * bands.BandSize, 1, bands.PackedSize[i], file);
+	}
+
+	// write the palette
+	putc (12, file);		// palette ID byte
+	fwrite (palette, 3, 256, file);
+
+	fclose (file);
+	free (bands.Packed);
+	free (bands.PackedSize);
 
-		for (x = width - 1; x > 0; x--)
+	return 0;
+}
+
+static void PackPCXBand (void *userdata, int band)
+{
+	PCXBands *bands = (PCXBands *)userdata;
+	UBYTE *dest = bands->Packed + band * bands->BandSize;
+	UBYTE *dest_p = dest;
+	int y = band * bands->BandHeight;
+	int stop = y + bands->BandHeight;
+
+	if (stop > bands->Height)
+		stop = bands->Height;
+
+	for (; y < stop; ++y)
+	{
+		dest_p += PackPCXRow (dest_p, bands->Data + y * bands->Pitch, bands->Width);
+	}
+	bands->PackedSize[band] = dest_p - dest;
+}
+
+// Packs one scanline. dest must have room for width*2+1 bytes.
+static int PackPCXRow (UBYTE *dest, UBYTE *data, int width)
+{
+	UBYTE *dest_p = dest;
+	int x;
+	int runlen;
+	UBYTE color;
+
+	color = *data++;
+	runlen = 1;
+
+	for (x = width - 1; x > 0; x--)
+	{
+		if (*data == color)
 		{
-			if (*data == color)
-			{
-				runlen++;
-			}
-			else
+			runlen++;
+		}
+		else
+		{
+			if (runlen > 1 || color >= 0xc0)
 			{
-				if (runlen > 1 || color >= 0xc0)
+				while (runlen > 63)
 				{
-					while (runlen > 63)
-					{
-						putc (0xff, file);
-						putc (color, file);
-						runlen -= 63;
-					}
-					if (runlen > 0)
-					{
-						putc (0xc0 + runlen, file);
-					}
+					*dest_p++ = 0xff;
+					*dest_p++ = color;
+					runlen -= 63;
 				}
 				if (runlen > 0)
 				{
-					putc (color, file);
+					*dest_p++ = 0xc0 + runlen;
 				}
-				runlen = 1;
-				color = *data;
-			}
-			data++;
-		}
-
-		if (runlen > 1 || color >= 0xc0)
-		{
-			while (runlen > 63)
-			{
-				putc (0xff, file);
-				putc (color, file);
-				runlen -= 63;
 			}
 			if (runlen > 0)
 			{
-				putc (0xc0 + runlen, file);
+				*dest_p++ = color;
 			}
+			runlen = 1;
+			color = *data;
+		}
+		data++;
+	}
+
+	if (runlen > 1 || color >= 0xc0)
+	{
+		while (runlen > 63)
+		{
+			*dest_p++ = 0xff;
+			*dest_p++ = color;
+			runlen -= 63;
 		}
 		if (runlen > 0)
 		{
-			putc (color, file);
+			*dest_p++ = 0xc0 + runlen;
 		}
-
-		if (width & 1)
-			putc (0, file);
-
-		data += pitch - width;
+	}
+	if (runlen > 0)
+	{
+		*dest_p++ = color;
 	}
 
-	// write the palette
-	putc (12, file);		// palette ID byte
-	fwrite (palette, 3, 256, file);
-
-	fclose (file);
+	if (width & 1)
+		*dest_p++ = 0;
 
-	return 0;
+	return dest_p - dest;
 }
 
 int WriteBMPfile (const char *filename, UBYTE *data, int pitch, int height,
-	int width, UBYTE *palette)
+	int width, UBYTE *palette, bool rle)
 {
+	BitmapFileHeader fheader;
 	BitmapInfoHeader header;
 	FILE *file;
-	ULONG temp;
-	UBYTE zeros[8];
+	UBYTE *buffer, *buff_p;
 	int i;
-	int padwidth;
+	int padwidth, imagesize, headersize;
 
-	file = fopen (filename, "wb");
-	if (file == NULL)
+	padwidth = (width + 3) & (~3);
+	headersize = sizeof(fheader) + sizeof(header) + 1024;
+
+	// The entire file is assembled in memory and then written with a
+	// single fwrite. When packing, every row can grow to at most two
+	// bytes per pixel plus an end-of-line code.
+	if (rle)
+	{
+		imagesize = (width * 2 + 2) * height + 2;
+	}
+	else
 	{
-		fprintf (stderr, "Cannot open %s\n", filename);
+		imagesize = padwidth * height;
+	}
+	buffer = malloc (headersize + imagesize);
+	if (buffer == NULL)
+	{
+		Eprintf ("Out of memory\n");
 		return 1;
 	}
 
-	padwidth = (width + 3) & (~3);
-	memset (zeros, 0, sizeof(zeros));
+	buff_p = buffer + headersize;
+	if (rle)
+	{
+		for (i = height-1; i >= 0; --i)
+		{
+			buff_p += PackRLE8Row (buff_p, data+i*pitch, width);
+			*buff_p++ = 0;		// end of line
+			*buff_p++ = 0;
+		}
+		*buff_p++ = 0;			// end of bitmap
+		*buff_p++ = 1;
+		imagesize = buff_p - buffer - headersize;
+	}
+	else
+	{
+		for (i = height-1; i >= 0; --i)
+		{
+			memcpy (buff_p, data+i*pitch, width);
+			memset (buff_p + width, 0, padwidth - width);
+			buff_p += padwidth;
+		}
+	}
 
-	fwrite ("BM", 2, 1, file);
-	temp = LittleLong (sizeof(BitmapInfoHeader) + 1024 + 14 + padwidth * height);
-	fwrite (&temp, 4, 1, file);
-	temp = 0;
-	fwrite (&temp, 4, 1, file);
-	temp = sizeof(BitmapInfoHeader) + 1024 + 14;
-	fwrite (&temp, 4, 1, file);
+	fheader.id[0] = 'B';
+	fheader.id[1] = 'M';
+	fheader.size = LittleLong (headersize + imagesize);
+	fheader.reserved1 = 0;
+	fheader.reserved2 = 0;
+	fheader.offBits = LittleLong (headersize);
+	memcpy (buffer, &fheader, sizeof(fheader));
 
 	header.size = LittleLong (sizeof(header));
 	header.w = LittleLong (width);
 	header.h = LittleLong (height);
 	header.nPlanes = LittleShort (1);
 	header.bitCount = LittleShort (8);
-	header.compression = 0;
-	header.sizeImage = padwidth * height;
+	header.compression = LittleLong (rle ? BI_RLE8 : BI_RGB);
+	header.sizeImage = LittleLong (imagesize);
 	header.xPelsPerMeter = LittleLong (5039);
 	header.yPelsPerMeter = LittleLong (5039);
 	header.clrUsed = 0;
 	header.clrImportant = 0;
-	fwrite (&header, sizeof(header), 1, file);
+	memcpy (buffer + sizeof(fheader), &header, sizeof(header));
 
+	buff_p = buffer + sizeof(fheader) + sizeof(header);
 	for (i = 0; i < 256; ++i)
 	{
-		temp = MAKE_ID (palette[i*3+2], palette[i*3+1], palette[i*3], 0);
-		fwrite (&temp, 4, 1, file);
+		buff_p[0] = palette[i*3+2];
+		buff_p[1] = palette[i*3+1];
+		buff_p[2] = palette[i*3];
+		buff_p[3] = 0;
+		buff_p += 4;
+	}
+
+	file = fopen (filename, "wb");
+	if (file == NULL)
+	{
+		Eprintf ("Cannot open %s\n", filename);
+		free (buffer);
+		return 1;
+	}
+
+	i = fwrite (buffer, 1, headersize + imagesize, file) != (size_t)(headersize + imagesize);
+	free (buffer);
+	fclose (file);
+	if (rle && !i)
+	{
+		Printf ("compressed to %d (%d smaller than uncompressed)\n",
+			imagesize, padwidth * height - imagesize);
 	}
+	return i;
+}
 
-	padwidth = padwidth - width;
+// Packs one row using BI_RLE8 encoded and absolute runs, without the
+// end-of-line code. Returns the number of bytes written to dest.
+static int PackRLE8Row (UBYTE *dest, UBYTE *src, int width)
+{
+	UBYTE *dest_p = dest;
+	int x, run, lit;
 
-	for (i = height-1; i >= 0; --i)
+	for (x = 0; x < width; )
 	{
-		if (fwrite (data+i*pitch, 1, width, file) != (unsigned)width ||
-			(padwidth && fwrite (zeros, 1, padwidth, file) != (unsigned)padwidth))
+		// Count how many times this pixel repeats
+		for (run = 1; x + run < width && run < 255 && src[x+run] == src[x]; ++run)
+			;
+
+		if (run >= 2)
 		{
-			fclose (file);
-			return 1;
+			*dest_p++ = run;
+			*dest_p++ = src[x];
+			x += run;
+			continue;
 		}
-	}
 
-	fclose (file);
-	return 0;
+		// Gather pixels until we find a run of at least three
+		for (lit = 1; x + lit < width && lit < 255; ++lit)
+		{
+			if (x + lit + 2 < width &&
+				src[x+lit] == src[x+lit+1] && src[x+lit] == src[x+lit+2])
+			{
+				break;
+			}
+		}
+
+		if (lit < 3)
+		{ // Absolute mode needs at least three pixels
+			for (run = 0; run < lit; ++run)
+			{
+				*dest_p++ = 1;
+				*dest_p++ = src[x+run];
+			}
+		}
+		else
+		{
+			*dest_p++ = 0;
+			*dest_p++ = lit;
+			memcpy (dest_p, src + x, lit);
+			dest_p += lit;
+			if (lit & 1)
+			{ // Absolute runs are padded to a word boundary
+				*dest_p++ = 0;
+			}
+		}
+		x += lit;
+	}
+	return dest_p - dest;
 }
 
 int WriteILBMfile (const char *filename, UBYTE *data, int pitch, int height,
@@ -225,15 +412,19 @@ int WriteILBMfile (const char *filename, UBYTE *data, int pitch, int height,
 
 	if (planewidth > MAXPLANEWIDTH)
 	{
-		fprintf (stderr, "%s is too wide. (Max is %d pixels.)\n",
+		Eprintf ("%s is too wide. (Max is %d pixels.)\n",
 			filename, MAXPLANEWIDTH*8);
 		return 1;
 	}
 
+#ifdef _DEBUG
+	TestILBM ();
+#endif
+
 	file = fopen (filename, "wb");
 	if (file == NULL)
 	{
-		fprintf (stderr, "Could not open %s for writing\n", filename);
+		Eprintf ("Could not open %s for writing\n", filename);
 		return 1;
 	}
 
@@ -297,8 +488,7 @@ int WriteILBMfile (const char *filename, UBYTE *data, int pitch, int height,
 	{
 		int plane;
 
-		memset (planes, 0, sizeof(planes));
-		c2p (planes[0], MAXPLANEWIDTH, data + i*pitch, width);
+		c2p (planes[0], MAXPLANEWIDTH, planewidth, data + i*pitch, width);
 		for (plane = 0; plane < 8; ++plane)
 		{
 			BYTE *source_p = &planes[plane][0];
@@ -322,20 +512,488 @@ int WriteILBMfile (const char *filename, UBYTE *data, int pitch, int height,
 	return 0;
 }
 
-static void c2p (UBYTE *planes, int planewidth, UBYTE *src, int width)
+int WritePatchfile (const char *filename, UBYTE *data, int pitch, int height,
+	int width, int cx, int cy)
 {
-	int i, j;
+	UBYTE *buffer, *column;
+	ULONG *hashes;
+	int *sizes;
+	int headersize, maxcolsize, size, shared;
+	int x, i;
+	FILE *file;
+
+	if (width > 0xFFFF || height > 0xFFFF)
+	{
+		Eprintf ("%s is too big for a patch\n", filename);
+		return 1;
+	}
+
+	// Worst case for a column is alternating opaque and transparent
+	// pixels, plus the empty posts needed to step through tall patches.
+	headersize = 8 + width * 4;
+	maxcolsize = height + (height / 2 + 1) * 4 + (height / 254 + 2) * 4 + 1;
+	buffer = malloc (headersize + width * maxcolsize);
+	hashes = malloc (width * sizeof(ULONG));
+	sizes = malloc (width * sizeof(int));
+	if (buffer == NULL || hashes == NULL || sizes == NULL)
+	{
+		Eprintf ("Out of memory\n");
+		free (buffer);
+		free (hashes);
+		free (sizes);
+		return 1;
+	}
+
+	buffer[0] = width & 255;	buffer[1] = width >> 8;
+	buffer[2] = height & 255;	buffer[3] = height >> 8;
+	buffer[4] = cx & 255;		buffer[5] = (cx >> 8) & 255;
+	buffer[6] = cy & 255;		buffer[7] = (cy >> 8) & 255;
 
-	for (i = 0; i < width; ++i)
+	// Columns that come out byte-for-byte identical are only stored once,
+	// and their ColumnOfs entries all point at the same data.
+	size = headersize;
+	shared = 0;
+	for (x = 0; x < width; ++x)
 	{
-		UBYTE chunk = src[i];
-		int bit = 7-(i&7);
-		int byt = i>>3;
+		ULONG ofs, hash;
+		int len;
 
-		for (j = 0; j < 8; ++j)
+		column = buffer + size;
+		len = PackPatchColumn (column, data + x, pitch, height);
+		for (hash = 0, i = 0; i < len; ++i)
+		{
+			hash = hash * 31 + column[i];
+		}
+		ofs = size;
+		for (i = 0; i < x; ++i)
+		{
+			if (hashes[i] == hash && sizes[i] == len)
+			{
+				ULONG prev = buffer[8+i*4] | (buffer[9+i*4] << 8) |
+					(buffer[10+i*4] << 16) | (buffer[11+i*4] << 24);
+				if (memcmp (buffer + prev, column, len) == 0)
+				{
+					ofs = prev;
+					break;
+				}
+			}
+		}
+		if (i < x)
+		{
+			shared++;
+		}
+		else
 		{
-			planes[j*planewidth+byt] |= (chunk&1) << bit;
-			chunk >>= 1;
+			size += len;
+		}
+		hashes[x] = hash;
+		sizes[x] = len;
+		buffer[8+x*4] = ofs & 255;
+		buffer[9+x*4] = (ofs >> 8) & 255;
+		buffer[10+x*4] = (ofs >> 16) & 255;
+		buffer[11+x*4] = ofs >> 24;
+	}
+
+	free (hashes);
+	free (sizes);
+
+	file = fopen (filename, "wb");
+	if (file == NULL)
+	{
+		Eprintf ("Could not open %s\n", filename);
+		free (buffer);
+		return 1;
+	}
+	i = fwrite (buffer, 1, size, file) != (size_t)size;
+	fclose (file);
+	free (buffer);
+
+	Printf ("%d bytes (%d of %d columns shared)\n", size, shared, width);
+	return i;
+}
+
+// Packs one column of a patch into posts. Every post covers as much of
+// an opaque span as it can, so a span is only split when it is longer
+// than 255 pixels. Color 0 is transparent and 247 is stored as 0, which
+// undoes what LoadPatch does.
+//
+// Tall patches use the DeepSea convention: a topdelta that is not past
+// the previous post's top is relative to that top. Empty posts are
+// inserted where a jump is too big to express that way.
+static int PackPatchColumn (UBYTE *dest, UBYTE *src, int pitch, int height)
+{
+	UBYTE *dest_p = dest;
+	int y, top, len, i;
+	int lasttop = -1;
+
+	for (y = 0; y < height; )
+	{
+		if (src[y*pitch] == 0)
+		{
+			y++;
+			continue;
+		}
+		for (len = 1; y + len < height && len < 255 && src[(y+len)*pitch] != 0; ++len)
+			;
+
+		// Step down with empty posts until y can be reached
+		while (y > 254 && y - lasttop > (lasttop < 254 ? lasttop : 254))
+		{
+			top = lasttop < 254 ? 254 : lasttop + 254;
+			dest_p[0] = 254;
+			dest_p[1] = 0;
+			dest_p[2] = 0;
+			dest_p[3] = 0;
+			dest_p += 4;
+			lasttop = top;
+		}
+
+		dest_p[0] = y <= 254 ? y : y - lasttop;
+		dest_p[1] = len;
+		dest_p[2] = 0;
+		for (i = 0; i < len; ++i)
+		{
+			UBYTE c = src[(y+i)*pitch];
+			dest_p[3+i] = c != 247 ? c : 0;
+		}
+		dest_p[3+len] = 0;
+		dest_p += len + 4;
+		lasttop = y;
+		y += len;
+	}
+	*dest_p++ = 255;
+	return dest_p - dest;
+}
+
+int WritePNGfile (const char *filename, UBYTE *data, int pitch, int height,
+	int width, int cx, int cy, UBYTE *palette, int level)
+{
+	UBYTE ihdr[13], grab[8], trns[1];
+	UBYTE *filtered, *compressed;
+	int complen, numcolors;
+	int x, y;
+	FILE *file;
+
+	// Every row is stored with a filter type byte in front of it
+	filtered = malloc ((width + 1) * height);
+	if (filtered == NULL)
+	{
+		Eprintf ("Out of memory\n");
+		return 1;
+	}
+	numcolors = 1;
+	for (y = 0; y < height; ++y)
+	{
+		UBYTE *row = data + y*pitch;
+
+		FilterPNGRow (filtered + y*(width+1), row, y > 0 ? row - pitch : NULL, width, level);
+		for (x = 0; x < width; ++x)
+		{
+			if (row[x] >= numcolors)
+				numcolors = row[x] + 1;
+		}
+	}
+	compressed = ZlibCompress (filtered, (width + 1) * height, level, &complen);
+	free (filtered);
+	if (compressed == NULL)
+	{
+		return 1;
+	}
+
+	file = fopen (filename, "wb");
+	if (file == NULL)
+	{
+		Eprintf ("Could not open %s\n", filename);
+		free (compressed);
+		return 1;
+	}
+
+	fwrite ("\x89PNG\r\n\x1a\n", 1, 8, file);
+
+	ihdr[0] = width >> 24;	ihdr[1] = width >> 16;	ihdr[2] = width >> 8;	ihdr[3] = width;
+	ihdr[4] = height >> 24;	ihdr[5] = height >> 16;	ihdr[6] = height >> 8;	ihdr[7] = height;
+	ihdr[8] = 8;			// bit depth
+	ihdr[9] = 3;			// indexed color
+	ihdr[10] = 0;			// deflate
+	ihdr[11] = 0;			// adaptive filtering
+	ihdr[12] = 0;			// not interlaced
+	WritePNGChunk (file, "IHDR", ihdr, 13);
+
+	// ZDoom reads the sprite offsets from this
+	if (cx != 0x8000)
+	{
+		grab[0] = cx >> 24;	grab[1] = cx >> 16;	grab[2] = cx >> 8;	grab[3] = cx;
+		grab[4] = cy >> 24;	grab[5] = cy >> 16;	grab[6] = cy >> 8;	grab[7] = cy;
+		WritePNGChunk (file, "grAb", grab, 8);
+	}
+
+	// Only store as much of the palette as is actually used
+	WritePNGChunk (file, "PLTE", palette, numcolors * 3);
+	trns[0] = 0;
+	WritePNGChunk (file, "tRNS", trns, 1);
+	WritePNGChunk (file, "IDAT", compressed, complen);
+	WritePNGChunk (file, "IEND", NULL, 0);
+
+	x = ferror (file);
+	fclose (file);
+	free (compressed);
+
+	Printf ("compressed to %d (%d smaller than uncompressed)\n",
+		complen, width * height - complen);
+	return x != 0;
+}
+
+static int Paeth (int a, int b, int c)
+{
+	int p = a + b - c;
+	int pa = abs (p - a);
+	int pb = abs (p - b);
+	int pc = abs (p - c);
+
+	if (pa <= pb && pa <= pc)
+		return a;
+	else if (pb <= pc)
+		return b;
+	return c;
+}
+
+// Picks a filter for one row and writes the filtered row, preceded by
+// its filter type, to dest. At low effort levels rows are left
+// unfiltered, which is what usually works best for paletted images.
+// Otherwise the filter that gives the smallest sum of absolute
+// differences is used, with ties going to no filter at all.
+static void FilterPNGRow (UBYTE *dest, UBYTE *row, UBYTE *prev, int width, int level)
+{
+	ULONG sums[5];
+	int filter, best, x;
+
+	dest[0] = 0;
+	memcpy (dest + 1, row, width);
+	if (level <= 3)
+		return;
+
+	for (filter = 0; filter < 5; ++filter)
+	{
+		sums[filter] = 0;
+		for (x = 0; x < width; ++x)
+		{
+			int a = x > 0 ? row[x-1] : 0;
+			int b = prev != NULL ? prev[x] : 0;
+			int c = x > 0 && prev != NULL ? prev[x-1] : 0;
+			int p;
+
+			switch (filter)
+			{
+			case 0: p = row[x]; break;
+			case 1: p = row[x] - a; break;
+			case 2: p = row[x] - b; break;
+			case 3: p = row[x] - ((a + b) >> 1); break;
+			default: p = row[x] - Paeth (a, b, c); break;
+			}
+			sums[filter] += abs ((BYTE)p);
+		}
+	}
+	for (best = 0, filter = 1; filter < 5; ++filter)
+	{
+		if (sums[filter] < sums[best])
+			best = filter;
+	}
+	if (best == 0)
+		return;
+
+	dest[0] = best;
+	for (x = 0; x < width; ++x)
+	{
+		int a = x > 0 ? row[x-1] : 0;
+		int b = prev != NULL ? prev[x] : 0;
+		int c = x > 0 && prev != NULL ? prev[x-1] : 0;
+
+		switch (best)
+		{
+		case 1: dest[x+1] = row[x] - a; break;
+		case 2: dest[x+1] = row[x] - b; break;
+		case 3: dest[x+1] = row[x] - ((a + b) >> 1); break;
+		default: dest[x+1] = row[x] - Paeth (a, b, c); break;
+		}
+	}
+}
+
+static void WritePNGChunk (FILE *file, const char *id, UBYTE *data, int len)
+{
+	UBYTE head[8];
+	ULONG crc;
+
+	head[0] = len >> 24;	head[1] = len >> 16;	head[2] = len >> 8;	head[3] = len;
+	memcpy (head + 4, id, 4);
+	crc = CRC32 (0, head + 4, 4);
+	crc = CRC32 (crc, data, len);
+	fwrite (head, 1, 8, file);
+	if (len > 0)
+	{
+		fwrite (data, 1, len, file);
+	}
+	head[0] = (UBYTE)(crc >> 24);
+	head[1] = (UBYTE)(crc >> 16);
+	head[2] = (UBYTE)(crc >> 8);
+	head[3] = (UBYTE)crc;
+	fwrite (head, 1, 4, file);
+}
+
+// Converts one row of chunky pixels to eight bitplanes, stride bytes
+// apart. Every plane byte up to planewidth is written, so planes need
+// not be cleared first. Pixels past width are treated as color 0.
+static void c2p (UBYTE *planes, int stride, int planewidth, UBYTE *src, int width)
+{
+	UBYTE tail[8];
+	int x = 0;
+
+#ifdef USE_SSE2
+	for (; x + 16 <= width; x += 16)
+	{
+		c2p16 (planes + (x>>3), stride, src + x);
+	}
+#endif
+	for (; x + 8 <= width; x += 8)
+	{
+		c2p8 (planes + (x>>3), stride, src + x);
+	}
+	for (; x < planewidth*8; x += 8)
+	{
+		memset (tail, 0, sizeof(tail));
+		if (x < width)
+		{
+			memcpy (tail, src + x, width - x);
+		}
+		c2p8 (planes + (x>>3), stride, tail);
+	}
+}
+
+// Transposes an 8x8 bit matrix: eight pixels in, one byte for each of
+// the eight planes out. (Hacker's Delight, transpose8rS32)
+static void c2p8 (UBYTE *planes, int planewidth, UBYTE *src)
+{
+	ULONG x, y, t;
+
+	x = (src[0]<<24) | (src[1]<<16) | (src[2]<<8) | src[3];
+	y = (src[4]<<24) | (src[5]<<16) | (src[6]<<8) | src[7];
+
+	t = (x ^ (x >> 7)) & 0x00AA00AA;  x = x ^ t ^ (t << 7);
+	t = (y ^ (y >> 7)) & 0x00AA00AA;  y = y ^ t ^ (t << 7);
+
+	t = (x ^ (x >> 14)) & 0x0000CCCC;  x = x ^ t ^ (t << 14);
+	t = (y ^ (y >> 14)) & 0x0000CCCC;  y = y ^ t ^ (t << 14);
+
+	t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+	y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+	x = t;
+
+	// The most significant bit of each pixel comes out first
+	planes[7*planewidth] = (UBYTE)(x >> 24);
+	planes[6*planewidth] = (UBYTE)(x >> 16);
+	planes[5*planewidth] = (UBYTE)(x >> 8);
+	planes[4*planewidth] = (UBYTE)x;
+	planes[3*planewidth] = (UBYTE)(y >> 24);
+	planes[2*planewidth] = (UBYTE)(y >> 16);
+	planes[1*planewidth] = (UBYTE)(y >> 8);
+	planes[0]            = (UBYTE)y;
+}
+
+#ifdef USE_SSE2
+// Does sixteen pixels at once. After reversing the pixels within each
+// group of eight, shifting bit n of every byte up to the top lets
+// movemask collect two whole bytes of plane n.
+static void c2p16 (UBYTE *planes, int planewidth, UBYTE *src)
+{
+	__m128i pix = _mm_loadu_si128 ((__m128i *)src);
+	int plane;
+
+	pix = _mm_shufflelo_epi16 (pix, _MM_SHUFFLE(0,1,2,3));
+	pix = _mm_shufflehi_epi16 (pix, _MM_SHUFFLE(0,1,2,3));
+	pix = _mm_or_si128 (_mm_slli_epi16 (pix, 8), _mm_srli_epi16 (pix, 8));
+
+	for (plane = 7; plane >= 0; --plane)
+	{
+		int bits = _mm_movemask_epi8 (pix);
+		planes[plane*planewidth] = (UBYTE)bits;
+		planes[plane*planewidth+1] = (UBYTE)(bits >> 8);
+		pix = _mm_add_epi8 (pix, pix);
+	}
+}
+#endif
+
+#ifdef _DEBUG
+// Writes ILBMs of awkward widths and reads them back, to check that
+// c2p gets every pixel into the right place. Runs once.
+static void TestILBM (void)
+{
+	static const int widths[] = { 1, 7, 9, 15, 17, 31, 33, 63, 65, 127, 129, 1599 };
+	static bool tested;
+	UBYTE palette[768], readpal[768];
+	UBYTE *data, *readback;
+	char *name;
+	OutputLog *log;
+	int i, x, y, w, h, width, height, srcwidth, cx, cy;
+
+	if (tested)
+		return;
+	tested = true;
+
+	name = tmpnam (NULL);
+	memset (palette, 0, sizeof(palette));
+	h = 5;
+	data = malloc (1600 * h);
+	if (name == NULL || data == NULL)
+	{
+		free (data);
+		return;
+	}
+	for (i = 0; i < 1600 * h; ++i)
+	{
+		data[i] = (UBYTE)(i * 97 + (i >> 3));
+	}
+
+	for (i = 0; i < (int)(sizeof(widths)/sizeof(widths[0])); ++i)
+	{
+		w = widths[i];
+
+		// Don't let the messages from loading get mixed in with real ones.
+		log = StartLog ();
+		if (WriteILBMfile (name, data, 1600, h, w, 0x8000, 0, palette) == 0)
+		{
+			ForgetPic (name);
+			LoadPic (name, &readback, &width, &height, &srcwidth, &cx, &cy, readpal, 0);
+		}
+		else
+		{
+			readback = NULL;
+		}
+		EndLog ();
+		FreeLog (log);
+
+		if (readback == NULL || srcwidth != w || height != h)
+		{
+			Eprintf ("ILBM test: %d pixel wide image did not load back\n", w);
+		}
+		else
+		{
+			for (y = 0; y < h; ++y)
+			{
+				for (x = 0; x < w; ++x)
+				{
+					if (readback[x + y*width] != data[x + y*1600])
+						break;
+				}
+				if (x < w)
+				{
+					Eprintf ("ILBM test: %d pixel wide image is wrong at (%d,%d)\n", w, x, y);
+					break;
+				}
+			}
 		}
+		ReleasePic (readback);
 	}
+	ForgetPic (name);
+	remove (name);
+	free (data);
 }
+#endif
@@ -1,147 +1,54 @@
-#line 2 "lexxer.c"
-/* A lexical scanner generated by flex */
-
-/* Scanner skeleton version:
- * $Header: /home/daffy/u0/vern/flex/RCS/flex.skl,v 2.91 96/09/10 16:58:48 vern Exp $
+/* A reentrant lexical scanner generated from lexxer.l.
+ * Do not edit it; edit lexxer.l and regenerate it with
+ *	flex -is -olexxer.c lexxer.l
  */
 
-#define FLEX_SCANNER
-#define YY_FLEX_MAJOR_VERSION 2
-#define YY_FLEX_MINOR_VERSION 5
-
 #include <stdio.h>
-
-
-/* cfront 1.2 defines "c_plusplus" instead of "__cplusplus" */
-#ifdef c_plusplus
-#ifndef __cplusplus
-#define __cplusplus
-#endif
-#endif
-
-
-#ifdef __cplusplus
-
-#include <stdlib.h>
-#include <unistd.h>
-
-/* Use prototypes in function declarations. */
-#define YY_USE_PROTOS
-
-/* The "const" storage-class-modifier is valid. */
-#define YY_USE_CONST
-
-#else	/* ! __cplusplus */
-
-#if __STDC__
-
-#define YY_USE_PROTOS
-#define YY_USE_CONST
-
-#endif	/* __STDC__ */
-#endif	/* ! __cplusplus */
-
-#ifdef __TURBOC__
- #pragma warn -rch
- #pragma warn -use
-#include <io.h>
+#include <string.h>
+#include <errno.h>
 #include <stdlib.h>
-#define YY_USE_CONST
-#define YY_USE_PROTOS
-#endif
-
-#ifdef YY_USE_CONST
-#define yyconst const
-#else
-#define yyconst
-#endif
-
 
-#ifdef YY_USE_PROTOS
-#define YY_PROTO(proto) proto
-#else
-#define YY_PROTO(proto) ()
+/* An opaque pointer. */
+#ifndef YY_TYPEDEF_YY_SCANNER_T
+#define YY_TYPEDEF_YY_SCANNER_T
+typedef void *yyscan_t;
 #endif
 
 /* Returned upon end-of-file. */
 #define YY_NULL 0
 
 /* Promotes a possibly negative, possibly signed char to an unsigned
- * integer for use as an array index.  If the signed char is negative,
- * we want to instead treat it as an 8-bit unsigned char, hence the
- * double cast.
- */
-#define YY_SC_TO_UI(c) ((unsigned int) (unsigned char) c)
-
-/* Enter a start condition.  This macro really ought to take a parameter,
- * but we do it the disgusting crufty way forced on us by the ()-less
- * definition of BEGIN.
+ * integer for use as an array index.
  */
-#define BEGIN yy_start = 1 + 2 *
-
-/* Translate the current start state into a value that can be later handed
- * to BEGIN to return to the state.  The YYSTATE alias is for lex
- * compatibility.
- */
-#define YY_START ((yy_start - 1) / 2)
-#define YYSTATE YY_START
-
-/* Action number for EOF rule of a given start state. */
-#define YY_STATE_EOF(state) (YY_END_OF_BUFFER + state + 1)
-
-/* Special action meaning "start processing a new file". */
-#define YY_NEW_FILE yyrestart( yyin )
+#define YY_SC_TO_UI(c) ((YY_CHAR) (c))
 
 #define YY_END_OF_BUFFER_CHAR 0
 
 /* Size of default input buffer. */
+#ifndef YY_BUF_SIZE
 #define YY_BUF_SIZE 16384
+#endif
 
-typedef struct yy_buffer_state *YY_BUFFER_STATE;
-
-extern int yyleng;
-extern FILE *yyin, *yyout;
-
-#define EOB_ACT_CONTINUE_SCAN 0
-#define EOB_ACT_END_OF_FILE 1
-#define EOB_ACT_LAST_MATCH 2
-
-/* The funky do-while in the following #define is used to turn the definition
- * int a single C statement (which needs a semi-colon terminator).  This
- * avoids problems with code like:
- *
- * 	if ( condition_holds )
- *		yyless( 5 );
- *	else
- *		do_something_else();
- *
- * Prior to using the do-while the compiler would get upset at the
- * "else" because it interpreted the "if" statement as being all
- * done when it reached the ';' after the yyless() call.
- */
+/* Amount of stuff to slurp up with each read. */
+#ifndef YY_READ_BUF_SIZE
+#define YY_READ_BUF_SIZE 8192
+#endif
 
-/* Return all but the first 'n' matched characters back to the input stream. */
+#ifndef YY_TYPEDEF_YY_BUFFER_STATE
+#define YY_TYPEDEF_YY_BUFFER_STATE
+typedef struct yy_buffer_state *YY_BUFFER_STATE;
+#endif
 
-#define yyless(n) \
-	do \
-		{ \
-		/* Undo effects of setting up yytext. */ \
-		*yy_cp = yy_hold_char; \
-		YY_RESTORE_YY_MORE_OFFSET \
-		yy_c_buf_p = yy_cp = yy_bp + n - YY_MORE_ADJ; \
-		YY_DO_BEFORE_ACTION; /* set up yytext again */ \
-		} \
-	while ( 0 )
-
-#define unput(c) yyunput( c, yytext_ptr )
-
-/* The following is because we cannot portably get our hands on size_t
- * (without autoconf's help, which isn't available because we want
- * flex-generated scanners to compile on their own).
- */
-typedef unsigned int yy_size_t;
+#ifndef YY_TYPEDEF_YY_SIZE_T
+#define YY_TYPEDEF_YY_SIZE_T
+typedef size_t yy_size_t;
+#endif
 
+typedef unsigned char YY_CHAR;
+typedef int yy_state_type;
 
+#ifndef YY_STRUCT_YY_BUFFER_STATE
+#define YY_STRUCT_YY_BUFFER_STATE
 struct yy_buffer_state
 	{
 	FILE *yy_input_file;
@@ -152,9 +59,9 @@ struct yy_buffer_state
 	/* Size of input buffer in bytes, not including room for EOB
 	 * characters.
 	 */
-	yy_size_t yy_buf_size;
+	int yy_buf_size;
 
-	/* Number of characters read into yy_ch_buf, not including EOB
+	/* Offset of the end of the data in the buffer, not including EOB
 	 * characters.
 	 */
 	int yy_n_chars;
@@ -165,324 +72,1330 @@ struct yy_buffer_state
 	 */
 	int yy_is_our_buffer;
 
-	/* Whether this is an "interactive" input source; if so, and
-	 * if we're using stdio for input, then we want to use getc()
-	 * instead of fread(), to make sure we stop fetching input after
-	 * each newline.
-	 */
-	int yy_is_interactive;
-
-	/* Whether we're considered to be at the beginning of a line.
-	 * If so, '^' rules will be active on the next match, otherwise
-	 * not.
-	 */
-	int yy_at_bol;
-
-	/* Whether to try to fill the input buffer when we reach the
-	 * end of it.
-	 */
-	int yy_fill_buffer;
-
 	int yy_buffer_status;
+
 #define YY_BUFFER_NEW 0
 #define YY_BUFFER_NORMAL 1
-	/* When an EOF's been seen but there's still some text to process
-	 * then we mark the buffer as YY_EOF_PENDING, to indicate that we
-	 * shouldn't try reading from the input source any more.  We might
-	 * still have a bunch of tokens to match, though, because of
-	 * possible backing-up.
-	 *
-	 * When we actually see the EOF, we change the status to "new"
-	 * (via yyrestart()), so that the user can continue scanning by
-	 * just pointing yyin at a new input file.
+	/* When an EOF's been seen nothing more is read from the file, even
+	 * if it has more, until the buffer is flushed or restarted.
 	 */
 #define YY_BUFFER_EOF_PENDING 2
 	};
+#endif /* !YY_STRUCT_YY_BUFFER_STATE */
 
-static YY_BUFFER_STATE yy_current_buffer = 0;
-
-/* We provide macros for accessing buffer states in case in the
- * future we want to put the buffer states in a more general
- * "scanner state".
- */
-#define YY_CURRENT_BUFFER yy_current_buffer
-
-
-/* yy_hold_char holds the character lost when yytext is formed. */
-static char yy_hold_char;
-
-static int yy_n_chars;		/* number of characters read into yy_ch_buf */
-
-
-int yyleng;
-
-/* Points to current character in buffer. */
-static char *yy_c_buf_p = (char *) 0;
-static int yy_init = 1;		/* whether we need to initialize */
-static int yy_start = 0;	/* start state number */
-
-/* Flag which is used to allow yywrap()'s to do buffer switches
- * instead of setting up a fresh yyin.  A bit of a hack ...
+/* The state buf must point to the beginning of the
+ * reentrant scanner's current buffer.
  */
-static int yy_did_buffer_switch_on_eof;
-
-void yyrestart YY_PROTO(( FILE *input_file ));
-
-void yy_switch_to_buffer YY_PROTO(( YY_BUFFER_STATE new_buffer ));
-void yy_load_buffer_state YY_PROTO(( void ));
-YY_BUFFER_STATE yy_create_buffer YY_PROTO(( FILE *file, int size ));
-void yy_delete_buffer YY_PROTO(( YY_BUFFER_STATE b ));
-void yy_init_buffer YY_PROTO(( YY_BUFFER_STATE b, FILE *file ));
-void yy_flush_buffer YY_PROTO(( YY_BUFFER_STATE b ));
-#define YY_FLUSH_BUFFER yy_flush_buffer( yy_current_buffer )
-
-YY_BUFFER_STATE yy_scan_buffer YY_PROTO(( char *base, yy_size_t size ));
-YY_BUFFER_STATE yy_scan_string YY_PROTO(( yyconst char *yy_str ));
-YY_BUFFER_STATE yy_scan_bytes YY_PROTO(( yyconst char *bytes, int len ));
-
-static void *yy_flex_alloc YY_PROTO(( yy_size_t ));
-static void *yy_flex_realloc YY_PROTO(( void *, yy_size_t ));
-static void yy_flex_free YY_PROTO(( void * ));
-
-#define yy_new_buffer yy_create_buffer
-
-#define yy_set_interactive(is_interactive) \
-	{ \
-	if ( ! yy_current_buffer ) \
-		yy_current_buffer = yy_create_buffer( yyin, YY_BUF_SIZE ); \
-	yy_current_buffer->yy_is_interactive = is_interactive; \
-	}
+#define YY_CURRENT_BUFFER yyg->yy_current_buffer
 
-#define yy_set_bol(at_bol) \
-	{ \
-	if ( ! yy_current_buffer ) \
-		yy_current_buffer = yy_create_buffer( yyin, YY_BUF_SIZE ); \
-	yy_current_buffer->yy_at_bol = at_bol; \
-	}
-
-#define YY_AT_BOL() (yy_current_buffer->yy_at_bol)
-
-
-#define yywrap() 1
-#define YY_SKIP_YYWRAP
-typedef unsigned char YY_CHAR;
-FILE *yyin = (FILE *) 0, *yyout = (FILE *) 0;
-typedef int yy_state_type;
-extern char *yytext;
-#define yytext_ptr yytext
-
-static yy_state_type yy_get_previous_state YY_PROTO(( void ));
-static yy_state_type yy_try_NUL_trans YY_PROTO(( yy_state_type current_state ));
-static int yy_get_next_buffer YY_PROTO(( void ));
-static void yy_fatal_error YY_PROTO(( yyconst char msg[] ));
+static void yy_fatal_error (const char msg[], yyscan_t yyscanner);
 
 /* Done after the current pattern has been matched and before the
  * corresponding action - sets up yytext.
  */
 #define YY_DO_BEFORE_ACTION \
-	yytext_ptr = yy_bp; \
-	yyleng = (int) (yy_cp - yy_bp); \
-	yy_hold_char = *yy_cp; \
+	yyg->yytext_r = yy_bp; \
+	yyg->yyleng_r = (int) (yy_cp - yy_bp); \
+	yyg->yy_hold_char = *yy_cp; \
 	*yy_cp = '\0'; \
-	yy_c_buf_p = yy_cp;
+	yyg->yy_c_buf_p = yy_cp;
+#define YY_NUM_RULES 49
+#define YY_NUM_EC 47
 
-#define YY_NUM_RULES 47
-#define YY_END_OF_BUFFER 48
-static yyconst short int yy_accept[160] =
+/* The rule each state accepts, if any. */
+static const short int yy_accept[154] =
     {   0,
-        0,    0,   48,   46,   45,   45,   44,   46,   44,   44,
-       44,   46,   44,   44,   44,   44,   44,    6,    6,   44,
-       44,   44,   44,   46,   46,   46,   46,   46,   46,   46,
-       46,   46,   46,   44,   43,    0,   11,    0,   29,   38,
-       30,    0,    0,   27,   35,   25,   36,   26,   37,    0,
-        9,    1,    2,   28,   10,    5,    6,    0,    6,    6,
-        0,   34,   40,   42,   41,   33,   31,    3,    3,    3,
-        3,    0,    0,    3,    3,    3,    3,    3,    3,   32,
-       39,    7,   22,    0,    9,    9,    0,   10,    5,    5,
-        0,    8,    6,    6,    4,   24,   23,    0,    0,    0,
-
-        0,    0,    0,    0,    0,    0,    0,    9,    0,    9,
-        0,   10,    5,    5,    8,    4,    4,    0,    0,   14,
-        0,   12,    0,    0,    0,    0,    0,    0,    9,    4,
-        4,    0,    0,   16,    0,    0,    0,    0,   15,    0,
-        0,   18,   21,    0,    0,   13,   19,   17,    0,    0,
-        0,    0,    0,    0,    0,    0,    0,   20,    0
+    0,   49,   48,   47,   49,   47,   49,   47,   47,   49,
+   47,   47,   47,   47,   47,    5,    5,   47,   47,   47,
+   23,   23,   23,   23,   23,   23,   23,   23,   23,   23,
+   23,   47,   47,   46,    0,   10,    0,   24,   32,   41,
+   33,    0,    0,   30,   38,   28,   39,   29,   40,    0,
+    8,    1,    2,   31,    9,    4,    0,    5,    5,    0,
+   37,   43,   45,   44,   36,   22,   23,   23,   23,    0,
+   23,   23,   23,   23,   23,   23,   34,   35,   42,    6,
+   25,    0,    8,    0,    9,    4,    4,    0,    7,    5,
+    3,   27,   26,   23,   23,   23,   23,   23,   23,   23,
+
+   23,   23,   23,    0,    8,    0,    9,    4,    7,    3,
+    3,   23,   23,   13,   23,   23,   11,   23,   23,   23,
+   23,   23,    3,   23,   23,   23,   15,   23,   23,   23,
+   23,   14,   23,   23,   23,   17,   20,   23,   23,   12,
+   18,   21,   16,   23,   23,   23,   23,   23,   23,   23,
+   23,   23,   19
     } ;
 
-static yyconst int yy_ec[256] =
-    {   0,
-        1,    1,    1,    1,    1,    1,    1,    1,    2,    3,
-        2,    2,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    2,    4,    5,    6,    1,    7,    8,    9,    6,
-        6,   10,   11,    6,   12,   13,   14,   15,   16,   16,
-       16,   16,   16,   16,   16,   17,   17,    6,    6,   18,
-       19,   20,   21,    1,   25,   26,   27,   28,   29,   30,
-       31,   32,   33,   24,   24,   34,   35,   36,   37,   38,
-       24,   39,   40,   41,   42,   43,   24,   44,   24,   24,
-        6,   22,    6,   23,   24,    1,   25,   26,   27,   28,
-
-       29,   30,   31,   32,   33,   24,   24,   34,   35,   36,
-       37,   38,   24,   39,   40,   41,   42,   43,   24,   44,
-       24,   24,    6,   45,    6,    6,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1
+/* The equivalence class of each character. */
+static const YY_CHAR yy_ec[256] =
+    {
+    1,    1,    1,    1,    1,    1,    1,    1,    1,    2,
+    3,    2,    2,    1,    1,    1,    1,    1,    1,    1,
+    1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+    1,    1,    2,    4,    5,    6,    7,    8,    9,   10,
+    6,    6,   11,   12,    6,   13,   14,   15,   16,   17,
+   17,   17,   17,   17,   17,   17,   18,   18,    6,    6,
+   19,   20,   21,   22,    1,   23,   24,   25,   26,   27,
+   28,   29,   30,   31,   32,   32,   33,   34,   35,   36,
+   37,   32,   38,   39,   40,   41,   42,   32,   43,   32,
+   32,    6,   44,    6,   45,   32,    1,   23,   24,   25,
+
+   26,   27,   28,   29,   30,   31,   32,   32,   33,   34,
+   35,   36,   37,   32,   38,   39,   40,   41,   42,   32,
+   43,   32,   32,    6,   46,    6,    6,    1,    1,    1,
+    1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+    1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+    1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+    1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+    1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+    1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+    1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+
+    1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+    1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+    1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+    1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+    1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
+    1,    1,    1,    1,    1,    1
     } ;
 
-static yyconst int yy_meta[46] =
-    {   0,
-        1,    1,    1,    1,    2,    1,    1,    1,    3,    1,
-        1,    1,    1,    1,    4,    4,    4,    1,    1,    1,
-        2,    2,    1,    5,    6,    6,    4,    4,    4,    6,
-        5,    5,    5,    5,    5,    7,    5,    5,    7,    5,
-        7,    5,    7,    5,    1
-    } ;
-
-static yyconst short int yy_base[165] =
-    {   0,
-        0,    0,  256,  257,  257,  257,  236,   41,  257,  235,
-       39,  231,  233,   37,   40,   38,   47,   54,   34,   46,
-      232,   53,  231,    0,  212,  211,  212,   70,  209,  206,
-      212,  204,  210,   49,  257,   69,  257,  238,  257,  257,
-      257,  231,    0,  257,  257,  257,  257,  257,  257,  226,
-       70,  257,  257,  257,   86,   48,    0,   94,  196,  203,
-        0,  217,  257,  257,  257,  216,  257,  257,  198,  197,
-      207,   71,  209,  205,  190,  195,  202,  201,  200,  257,
-      257,  257,  257,  102,  257,  106,  113,  257,  182,  189,
-      116,  122,  257,  257,   47,  257,  257,  104,  181,  190,
-
-      192,  184,  187,  189,  180,  182,  126,  130,  138,  257,
-      142,  146,  257,  257,  257,  171,  175,  171,  160,  257,
-      157,  257,  160,  151,  149,  141,  140,  150,  153,  257,
-      257,  142,  143,  257,  141,  138,  137,  134,  257,  130,
-      122,  257,  257,  117,  102,  257,  257,  257,   87,   83,
-       72,   56,   68,   47,   46,   40,   23,  257,  257,  187,
-      194,  198,  204,  208
-    } ;
-
-static yyconst short int yy_def[165] =
-    {   0,
-      159,    1,  159,  159,  159,  159,  159,  160,  159,  159,
-      159,  161,  159,  159,  159,  159,  159,  159,   18,  159,
-      159,  159,  159,  162,  162,  162,  162,  162,  162,  162,
-      162,  162,  162,  159,  159,  160,  159,  160,  159,  159,
-      159,  159,  163,  159,  159,  159,  159,  159,  159,  159,
-      159,  159,  159,  159,  159,   18,   19,  159,  159,  159,
-      164,  159,  159,  159,  159,  159,  159,  159,  159,  159,
-      159,  160,  161,  159,  159,  159,  159,  159,  159,  159,
-      159,  159,  159,  159,  159,  159,  159,  159,  159,  159,
-      159,  159,  159,  159,  164,  159,  159,  159,  159,  159,
-
-      159,  159,  159,  159,  159,  159,  159,  159,  159,  159,
-      159,  159,  159,  159,  159,  159,  159,  159,  159,  159,
-      159,  159,  159,  159,  159,  159,  159,  159,  159,  159,
-      159,  159,  159,  159,  159,  159,  159,  159,  159,  159,
-      159,  159,  159,  159,  159,  159,  159,  159,  159,  159,
-      159,  159,  159,  159,  159,  159,  159,  159,    0,  159,
-      159,  159,  159,  159
-    } ;
-
-static yyconst short int yy_nxt[303] =
-    {   0,
-        4,    5,    6,    7,    8,    9,   10,   11,   12,   13,
-       14,   15,   16,   17,   18,   19,   19,   20,   21,   22,
-        9,    4,   23,   24,   24,   24,   25,   24,   24,   26,
-       24,   24,   27,   28,   24,   29,   30,   24,   24,   31,
-       32,   24,   24,   33,   34,   37,   40,   45,   57,   57,
-       50,   47,   51,   51,   51,   46,   52,   41,   48,   49,
-       53,  158,   38,   62,   63,   54,   55,   80,   56,   56,
-       57,   65,   66,   37,   72,   37,  157,  159,   73,  156,
-      116,   89,   58,  155,   51,   51,   51,   59,  117,   90,
-       38,  159,   38,   81,  154,   60,  153,   61,   84,   85,
-
-       86,   86,   86,   85,   91,   91,   74,  152,   92,   92,
-       92,  151,  107,  107,   87,   88,  108,  108,  108,   88,
-       86,   86,   86,  111,  111,  150,  149,  112,  112,  112,
-       92,   92,   92,  118,  109,  110,   92,   92,   92,  110,
-      108,  108,  108,  119,  108,  108,  108,  148,  128,  128,
-      147,  115,  129,  129,  129,  115,  112,  112,  112,   85,
-      112,  112,  112,   85,  129,  129,  129,  129,  129,  129,
-      146,  145,  144,  143,  142,   88,  141,  140,  139,   88,
-      138,  137,  110,  136,  135,  134,  110,   36,   36,   36,
-       36,   36,   36,   36,   42,   42,  133,   42,   42,   42,
-
-       42,   68,   68,   68,   68,   42,   42,  132,  131,   42,
-       42,   95,  130,   95,  127,  126,  125,  124,  123,  122,
-      121,  120,  114,  113,  106,  105,  104,  103,  102,  101,
-       43,  100,   99,   98,   97,   96,   94,   93,   83,   82,
-      159,   79,   78,   77,   76,   75,   71,   70,   69,   67,
-       64,   44,   43,   39,   35,  159,    3,  159,  159,  159,
-      159,  159,  159,  159,  159,  159,  159,  159,  159,  159,
-      159,  159,  159,  159,  159,  159,  159,  159,  159,  159,
-      159,  159,  159,  159,  159,  159,  159,  159,  159,  159,
-      159,  159,  159,  159,  159,  159,  159,  159,  159,  159,
-
-      159,  159
-    } ;
-
-static yyconst short int yy_chk[303] =
-    {   0,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    1,    1,    1,    1,    1,
-        1,    1,    1,    1,    1,    8,   11,   14,   19,   19,
-       16,   15,   16,   16,   16,   14,   17,   11,   15,   15,
-       17,  157,    8,   20,   20,   17,   18,   34,   18,   18,
-       18,   22,   22,   36,   28,   72,  156,   19,   28,  155,
-       95,   56,   18,  154,   51,   51,   51,   18,   95,   56,
-       36,   56,   72,   34,  153,   18,  152,   18,   51,   51,
-
-       55,   55,   55,   51,   58,   58,   28,  151,   58,   58,
-       58,  150,   84,   84,   55,   55,   84,   84,   84,   55,
-       86,   86,   86,   87,   87,  149,  145,   87,   87,   87,
-       91,   91,   91,   98,   86,   86,   92,   92,   92,   86,
-      107,  107,  107,   98,  108,  108,  108,  144,  109,  109,
-      141,   92,  109,  109,  109,   92,  111,  111,  111,  108,
-      112,  112,  112,  108,  128,  128,  128,  129,  129,  129,
-      140,  138,  137,  136,  135,  112,  133,  132,  127,  112,
-      126,  125,  129,  124,  123,  121,  129,  160,  160,  160,
-      160,  160,  160,  160,  161,  161,  119,  161,  161,  161,
-
-      161,  162,  162,  162,  162,  163,  163,  118,  117,  163,
-      163,  164,  116,  164,  106,  105,  104,  103,  102,  101,
-      100,   99,   90,   89,   79,   78,   77,   76,   75,   74,
-       73,   71,   70,   69,   66,   62,   60,   59,   50,   42,
-       38,   33,   32,   31,   30,   29,   27,   26,   25,   23,
-       21,   13,   12,   10,    7,    3,  159,  159,  159,  159,
-      159,  159,  159,  159,  159,  159,  159,  159,  159,  159,
-      159,  159,  159,  159,  159,  159,  159,  159,  159,  159,
-      159,  159,  159,  159,  159,  159,  159,  159,  159,  159,
-      159,  159,  159,  159,  159,  159,  159,  159,  159,  159,
-
-      159,  159
+/* The state to go to from each state on each equivalence class, or 0 to
+ * jam.
+ */
+static const short int yy_nxt[154][YY_NUM_EC] =
+    {
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    2,    3,    3,    4,    5,    6,    7,    8,    9,
+   10,   11,   12,   13,   14,   15,   16,   17,   17,   18,
+   19,   20,    6,   21,   22,   23,   22,   22,   24,   22,
+   22,   25,   22,   26,   22,   27,   28,   22,   22,   29,
+   30,   22,   22,   31,    2,   32,   33
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   34,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,   35,   35,   35,   35,   36,   35,   35,   35,   35,
+   35,   35,   35,   35,   35,   35,   35,   35,   35,   35,
+   35,   35,   35,   35,   35,   35,   35,   35,   35,   35,
+   35,   35,   35,   35,   35,   35,   35,   35,   35,   35,
+   35,   35,   35,   35,   37,   35,   35
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,   38,   38,   38,   38,   38,   38,   38,
+   38,   38,   38,   38,   38,   38,   38,   38,   38,   38,
+   38,   38,   38,   38,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   39,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,   40,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   41,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,   42,   42,   42,   42,   42,   42,   42,   42,   42,
+    0,   42,   42,   42,   42,   42,   42,   42,   42,   42,
+   42,   42,   42,   42,   42,   42,   42,   42,   42,   42,
+   42,   42,   42,   42,   42,   42,   42,   42,   42,   42,
+   42,   42,   42,   42,   43,   42,   42
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   44,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,   45,    0,    0,    0,    0,    0,    0,    0,
+   46,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,   47,    0,    0,    0,    0,    0,    0,
+   48,   49,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,   50,    0,   51,   51,   51,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,   52,    0,    0,    0,   53,    0,    0,    0,    0,
+   54,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,   55,    0,   56,   56,   17,    0,
+    0,    0,    0,    0,    0,    0,    0,   57,    0,    0,
+    0,    0,    0,   58,    0,    0,    0,    0,    0,    0,
+    0,   59,    0,   60,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,   55,    0,   17,   17,   17,    0,
+    0,    0,    0,    0,    0,    0,    0,   57,    0,    0,
+    0,    0,    0,   58,    0,    0,    0,    0,    0,    0,
+    0,   59,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,   61,
+   62,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   63,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   64,   65,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   66,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   67,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   68,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   69,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,   35,    0,    0,    0,    0,
+   70,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   71,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   72,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   73,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   74,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   75,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   76,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   77,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   78,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   79
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,   35,   35,   35,   35,   36,   35,   35,   35,   35,
+   35,   35,   35,   35,   35,   35,   35,   35,   35,   35,
+   35,   35,   35,   35,   35,   35,   35,   35,   35,   35,
+   35,   35,   35,   35,   35,   35,   35,   35,   35,   35,
+   35,   35,   35,   35,   37,   35,   35
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,   35,   35,    0,   35,   35,   35,   35,   35,   35,
+   35,   35,   35,   35,   35,   35,   35,   35,   35,   35,
+   35,   35,   35,   35,   35,   35,   35,   35,   35,   35,
+   35,   35,   35,   35,   35,   35,   35,   35,   35,   35,
+   35,   35,   35,   35,   35,   35,   35
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   38,   38,   38,    0,
+    0,    0,    0,   38,   38,   38,   38,   38,   38,   38,
+   38,   38,   38,   38,   38,   38,   38,   38,   38,   38,
+   38,   38,   38,   38,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   80,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,   42,    0,    0,    0,    0,
+   42,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,   42,   42,   42,    0,    0,    0,   42,    0,
+    0,    0,    0,    0,    0,   42,    0,    0,   42,    0,
+   42,    0,   42,    0,   42,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,   81,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   51,   51,   51,    0,
+    0,    0,    0,    0,    0,    0,    0,   82,   83,    0,
+    0,    0,    0,   83,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   51,   51,   51,    0,
+    0,    0,    0,    0,    0,    0,    0,   84,   85,    0,
+    0,    0,    0,   85,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,   55,    0,   56,   56,   17,    0,
+    0,    0,    0,    0,    0,    0,    0,   57,    0,    0,
+    0,    0,    0,   86,    0,    0,    0,    0,    0,    0,
+    0,   87,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,   88,   88,    0,    0,   89,   89,   89,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,   90,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,   90,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   91,   91,   91,    0,
+    0,    0,    0,   91,   91,   91,   91,   91,   91,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   92,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+   93,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   94,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   95,   22,   22,   96,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   97,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,   42,   42,   42,   42,   42,   42,   42,   42,   42,
+    0,   42,   42,   42,   42,   42,   42,   42,   42,   42,
+   42,   42,   42,   42,   42,   42,   42,   42,   42,   42,
+   42,   42,   42,   42,   42,   42,   42,   42,   42,   42,
+   42,   42,   42,   42,   43,   42,   42
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   98,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   99,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,  100,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,  101,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,  102,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,  103,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,  104,  104,    0,    0,  105,  105,  105,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,  106,  106,    0,    0,  107,  107,  107,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,  108,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,  108,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   89,   89,   89,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   89,   89,   89,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,  109,    0,
+    0,    0,    0,  109,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   91,   91,   91,    0,
+    0,    0,    0,   91,   91,   91,   91,   91,   91,    0,
+    0,    0,    0,  110,    0,    0,    0,    0,    0,    0,
+    0,  111,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,  112,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,  113,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+  114,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,  115,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,  116,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,  117,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,  118,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,  119,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,  120,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,  121,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,  122,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,  105,  105,  105,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,  105,  105,  105,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,   83,    0,
+    0,    0,    0,   83,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,  107,  107,  107,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,  107,  107,  107,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,   85,    0,
+    0,    0,    0,   85,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,  123,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,  123,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,  124,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,  125,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,  126,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,  127,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,  128,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,  129,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,  130,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,  131,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,  132,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,  133,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,  134,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,  135,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,  136,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,  137,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,  138,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,  139,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+  140,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,  141,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+  142,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,  143,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,  144,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,  145,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,  146,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,  147,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+  148,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,  149,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,  150,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,  151,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,  152,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,  153,   22,
+   22,   22,   22,   22,    0,    0,    0
+    },
+
+    {
+    0,    0,    0,    0,    0,    0,    0,    0,    0,    0,
+    0,    0,    0,    0,    0,    0,   22,   22,   22,    0,
+    0,    0,    0,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,   22,   22,   22,   22,   22,   22,
+   22,   22,   22,   22,    0,    0,    0
+    }
     } ;
 
-static yy_state_type yy_last_accepting_state;
-static char *yy_last_accepting_cpos;
-
-/* The intent behind this definition is that it'll catch
- * any uses of REJECT which flex missed.
- */
-#define REJECT reject_used_but_not_detected
-#define yymore() yymore_used_but_not_detected
-#define YY_MORE_ADJ 0
-#define YY_RESTORE_YY_MORE_OFFSET
-char *yytext;
-#line 1 ".\\lexxer.l"
-#define INITIAL 0
+#line 1 "lexxer.l"
 /*
 ** lexxer.l
 ** The lexxer used by the script engine. Recognizes way more keywords than I
@@ -517,104 +1430,115 @@ char *yytext;
 ** THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 **---------------------------------------------------------------------------
 */
-#line 52 ".\\lexxer.l"
+#line 54 "lexxer.l"
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 #include "afx.h"
+#include "script.h"
 #include "parser.h"
 
-int column = 0;
-int lineno = 1;
+// The parser's yylex gets the scanner out of the ParseContext, which the
+// scanner keeps in yyextra for counting lines and columns.
+#define YY_DECL int ScriptLex (YYSTYPE *yylval_param, yyscan_t yyscanner)
 
-static void comment(void);
-static void cppcomment (void);
-static void count(void);
-static int intconst(void);
-static int charconst(void);
-static double floatconst(void);
-static char *stringconst(void);
-#line 538 "lexxer.c"
+static void comment(yyscan_t yyscanner);
+static void cppcomment (yyscan_t yyscanner);
+static void count(yyscan_t yyscanner);
+static int intconst(const char *text);
+static int charconst(const char *text);
+static double floatconst(const char *text);
+static char *stringconst(char *text, int len);
+#line 1453 "lexxer.c"
 
-/* Macros after this point can all be overridden by user definitions in
- * section 1.
- */
+#define INITIAL 0
 
-#ifndef YY_SKIP_YYWRAP
-#ifdef __cplusplus
-extern "C" int yywrap YY_PROTO(( void ));
-#else
-extern int yywrap YY_PROTO(( void ));
-#endif
-#endif
+#define YY_EXTRA_TYPE ParseContext *
 
-#ifndef YY_NO_UNPUT
-static void yyunput YY_PROTO(( int c, char *buf_ptr ));
-#endif
+/* Holds the entire state of the reentrant scanner. */
+struct yyguts_t
+	{
 
-#ifndef yytext_ptr
-static void yy_flex_strncpy YY_PROTO(( char *, yyconst char *, int ));
-#endif
+	/* User-defined. Not touched by flex. */
+	YY_EXTRA_TYPE yyextra_r;
 
-#ifdef YY_NEED_STRLEN
-static int yy_flex_strlen YY_PROTO(( yyconst char * ));
-#endif
+	/* The rest are the same as the globals declared in the non-reentrant scanner. */
+	FILE *yyin_r, *yyout_r;
+	YY_BUFFER_STATE yy_current_buffer;
+	char yy_hold_char;
+	int yyleng_r;
+	char *yy_c_buf_p;
+	int yy_init;
 
-#ifndef YY_NO_INPUT
-#ifdef __cplusplus
-static int yyinput YY_PROTO(( void ));
-#else
-static int input YY_PROTO(( void ));
-#endif
-#endif
+	yy_state_type yy_last_accepting_state;
+	char *yy_last_accepting_cpos;
 
-#if YY_STACK_USED
-static int yy_start_stack_ptr = 0;
-static int yy_start_stack_depth = 0;
-static int *yy_start_stack = 0;
-#ifndef YY_NO_PUSH_STATE
-static void yy_push_state YY_PROTO(( int new_state ));
-#endif
-#ifndef YY_NO_POP_STATE
-static void yy_pop_state YY_PROTO(( void ));
-#endif
-#ifndef YY_NO_TOP_STATE
-static int yy_top_state YY_PROTO(( void ));
-#endif
+	char *yytext_r;
 
-#else
-#define YY_NO_PUSH_STATE 1
-#define YY_NO_POP_STATE 1
-#define YY_NO_TOP_STATE 1
-#endif
+	YYSTYPE *yylval_r;
 
-#ifdef YY_MALLOC_DECL
-YY_MALLOC_DECL
-#else
-#if __STDC__
-#ifndef __cplusplus
-#include <stdlib.h>
-#endif
-#else
-/* Just try to get by without declaring the routines.  This will fail
- * miserably on non-ANSI systems for which sizeof(size_t) != sizeof(int)
- * or sizeof(void*) != sizeof(int).
- */
-#endif
-#endif
+	}; /* end struct yyguts_t */
 
-/* Amount of stuff to slurp up with each read. */
-#ifndef YY_READ_BUF_SIZE
-#define YY_READ_BUF_SIZE 8192
+#define yyin yyg->yyin_r
+#define yyout yyg->yyout_r
+#define yyextra yyg->yyextra_r
+#define yyleng yyg->yyleng_r
+#define yytext yyg->yytext_r
+
+#define yylval yyg->yylval_r
+
+int yylex_init (yyscan_t *scanner);
+
+int yylex_init_extra (YY_EXTRA_TYPE user_defined, yyscan_t *scanner);
+
+/* Accessor methods to globals.
+   These are made visible to non-reentrant scanners for convenience. */
+
+int yylex_destroy (yyscan_t yyscanner);
+
+YY_EXTRA_TYPE yyget_extra (yyscan_t yyscanner);
+
+void yyset_extra (YY_EXTRA_TYPE user_defined, yyscan_t yyscanner);
+
+FILE *yyget_in (yyscan_t yyscanner);
+
+void yyset_in (FILE *_in_str, yyscan_t yyscanner);
+
+FILE *yyget_out (yyscan_t yyscanner);
+
+void yyset_out (FILE *_out_str, yyscan_t yyscanner);
+
+int yyget_leng (yyscan_t yyscanner);
+
+char *yyget_text (yyscan_t yyscanner);
+
+YYSTYPE *yyget_lval (yyscan_t yyscanner);
+
+void yyset_lval (YYSTYPE *yylval_param, yyscan_t yyscanner);
+
+void yyrestart (FILE *input_file, yyscan_t yyscanner);
+YY_BUFFER_STATE yy_create_buffer (FILE *file, int size, yyscan_t yyscanner);
+void yy_switch_to_buffer (YY_BUFFER_STATE new_buffer, yyscan_t yyscanner);
+void yy_delete_buffer (YY_BUFFER_STATE b, yyscan_t yyscanner);
+void yy_flush_buffer (YY_BUFFER_STATE b, yyscan_t yyscanner);
+YY_BUFFER_STATE yy_scan_string (const char *yy_str, yyscan_t yyscanner);
+YY_BUFFER_STATE yy_scan_bytes (const char *bytes, int len, yyscan_t yyscanner);
+
+void *yyalloc (yy_size_t size, yyscan_t yyscanner);
+void *yyrealloc (void *ptr, yy_size_t size, yyscan_t yyscanner);
+void yyfree (void *ptr, yyscan_t yyscanner);
+
+static void yy_load_buffer_state (yyscan_t yyscanner);
+static void yy_init_buffer (YY_BUFFER_STATE b, FILE *file, yyscan_t yyscanner);
+static int yy_get_next_buffer (char **bp, char **cp, yyscan_t yyscanner);
+
+#ifndef YY_NO_INPUT
+static int input (yyscan_t yyscanner);
 #endif
 
 /* Copy whatever the last rule matched to the standard output. */
-
 #ifndef ECHO
-/* This used to be an fputs(), but since the string might contain NUL's,
- * we now use fwrite().
- */
-#define ECHO (void) fwrite( yytext, yyleng, 1, yyout )
+#define ECHO do { if (fwrite (yytext, (size_t) yyleng, 1, yyout)) {} } while (0)
 #endif
 
 /* Gets input and stuffs it into "buf".  number of characters read, or YY_NULL,
@@ -622,21 +1546,17 @@ YY_MALLOC_DECL
  */
 #ifndef YY_INPUT
 #define YY_INPUT(buf,result,max_size) \
-	if ( yy_current_buffer->yy_is_interactive ) \
+	errno = 0; \
+	while ((result = (int) fread (buf, 1, (yy_size_t) max_size, yyin)) == 0 && ferror (yyin)) \
 		{ \
-		int c = '*', n; \
-		for ( n = 0; n < max_size && \
-			     (c = getc( yyin )) != EOF && c != '\n'; ++n ) \
-			buf[n] = (char) c; \
-		if ( c == '\n' ) \
-			buf[n++] = (char) c; \
-		if ( c == EOF && ferror( yyin ) ) \
-			YY_FATAL_ERROR( "input in flex scanner failed" ); \
-		result = n; \
-		} \
-	else if ( ((result = fread( buf, 1, max_size, yyin )) == 0) \
-		  && ferror( yyin ) ) \
-		YY_FATAL_ERROR( "input in flex scanner failed" );
+		if (errno != EINTR) \
+			{ \
+			YY_FATAL_ERROR ("input in flex scanner failed"); \
+			break; \
+			} \
+		errno = 0; \
+		clearerr (yyin); \
+		}
 #endif
 
 /* No semi-colon after return; correct usage is to write "yyterminate();" -
@@ -647,22 +1567,21 @@ YY_MALLOC_DECL
 #define yyterminate() return YY_NULL
 #endif
 
-/* Number of entries by which start-condition stack grows. */
-#ifndef YY_START_STACK_INCR
-#define YY_START_STACK_INCR 25
-#endif
-
 /* Report a fatal error. */
 #ifndef YY_FATAL_ERROR
-#define YY_FATAL_ERROR(msg) yy_fatal_error( msg )
+#define YY_FATAL_ERROR(msg) yy_fatal_error (msg, yyscanner)
 #endif
 
 /* Default declaration of generated scanner - a define so the user can
  * easily add parameters.
  */
 #ifndef YY_DECL
-#define YY_DECL int yylex YY_PROTO(( void ))
-#endif
+#define YY_DECL_IS_OURS 1
+extern int yylex (YYSTYPE *yylval_param, yyscan_t yyscanner);
+
+#define YY_DECL int yylex \
+		(YYSTYPE *yylval_param, yyscan_t yyscanner)
+#endif /* !YY_DECL */
 
 /* Code executed at the beginning of each rule, after yytext and yyleng
  * have been set up.
@@ -673,944 +1592,571 @@ YY_MALLOC_DECL
 
 /* Code executed at the end of each rule. */
 #ifndef YY_BREAK
-#define YY_BREAK break;
+#define YY_BREAK /*LINTED*/break;
 #endif
 
 #define YY_RULE_SETUP \
 	YY_USER_ACTION
 
+/** The main scanner function which does all the work.
+ */
 YY_DECL
-	{
-	register yy_state_type yy_current_state;
-	register char *yy_cp, *yy_bp;
-	register int yy_act;
-
-#line 70 ".\\lexxer.l"
+{
+	yy_state_type yy_current_state;
+	char *yy_cp, *yy_bp;
+	int yy_act;
+	struct yyguts_t *yyg = (struct yyguts_t *)yyscanner;
 
-#line 691 "lexxer.c"
+	yylval = yylval_param;
 
-	if ( yy_init )
+	if (!yyg->yy_init)
 		{
-		yy_init = 0;
-
-#ifdef YY_USER_INIT
-		YY_USER_INIT;
-#endif
-
-		if ( ! yy_start )
-			yy_start = 1;	/* first start state */
+		yyg->yy_init = 1;
 
-		if ( ! yyin )
+		if (!yyin)
 			yyin = stdin;
 
-		if ( ! yyout )
+		if (!yyout)
 			yyout = stdout;
 
-		if ( ! yy_current_buffer )
-			yy_current_buffer =
-				yy_create_buffer( yyin, YY_BUF_SIZE );
+		if (!YY_CURRENT_BUFFER)
+			YY_CURRENT_BUFFER = yy_create_buffer (yyin, YY_BUF_SIZE, yyscanner);
 
-		yy_load_buffer_state();
+		yy_load_buffer_state (yyscanner);
 		}
 
-	while ( 1 )		/* loops until end-of-file is reached */
+	for (;;)		/* loops until end-of-file is reached */
 		{
-		yy_cp = yy_c_buf_p;
+		yy_cp = yyg->yy_c_buf_p;
 
 		/* Support of yytext. */
-		*yy_cp = yy_hold_char;
+		*yy_cp = yyg->yy_hold_char;
 
 		/* yy_bp points to the position in yy_ch_buf of the start of
 		 * the current run.
 		 */
 		yy_bp = yy_cp;
 
-		yy_current_state = yy_start;
-yy_match:
-		do
+		yy_current_state = 1;
+		yyg->yy_last_accepting_cpos = NULL;
+
+		/* Take the longest match, reading more input whenever the
+		 * match runs into the end of the buffer.
+		 */
+		for (;;)
 			{
-			register YY_CHAR yy_c = yy_ec[YY_SC_TO_UI(*yy_cp)];
-			if ( yy_accept[yy_current_state] )
-				{
-				yy_last_accepting_state = yy_current_state;
-				yy_last_accepting_cpos = yy_cp;
-				}
-			while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
+			yy_state_type yy_next_state;
+
+			if (yy_cp == &YY_CURRENT_BUFFER->yy_ch_buf[YY_CURRENT_BUFFER->yy_n_chars] &&
+				yy_get_next_buffer (&yy_bp, &yy_cp, yyscanner) == 0)
+				break;
+
+			yy_next_state = yy_nxt[yy_current_state][yy_ec[YY_SC_TO_UI (*yy_cp)]];
+			if (yy_next_state == 0)
+				break;
+
+			yy_current_state = yy_next_state;
+			++yy_cp;
+			if (yy_accept[yy_current_state])
 				{
-				yy_current_state = (int) yy_def[yy_current_state];
-				if ( yy_current_state >= 160 )
-					yy_c = yy_meta[(unsigned int) yy_c];
+				yyg->yy_last_accepting_state = yy_current_state;
+				yyg->yy_last_accepting_cpos = yy_cp;
 				}
-			yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
-			++yy_cp;
 			}
-		while ( yy_base[yy_current_state] != 257 );
-
-yy_find_action:
-		yy_act = yy_accept[yy_current_state];
-		if ( yy_act == 0 )
-			{ /* have to back up */
-			yy_cp = yy_last_accepting_cpos;
-			yy_current_state = yy_last_accepting_state;
-			yy_act = yy_accept[yy_current_state];
-			}
-
-		YY_DO_BEFORE_ACTION;
 
+		if (yyg->yy_last_accepting_cpos == NULL)
+			{
+			if (yy_cp == yy_bp &&
+				yy_cp == &YY_CURRENT_BUFFER->yy_ch_buf[YY_CURRENT_BUFFER->yy_n_chars])
+				{ /* end of file */
+				yyg->yy_c_buf_p = yy_cp;
+				yyg->yy_hold_char = *yy_cp;
+				yyterminate ();
+				}
+			YY_FATAL_ERROR ("flex scanner jammed");
+			}
 
-do_action:	/* This label is used only to access EOF actions. */
+		yy_cp = yyg->yy_last_accepting_cpos;
+		yy_act = yy_accept[yyg->yy_last_accepting_state];
 
+		YY_DO_BEFORE_ACTION;
 
-		switch ( yy_act )
+		switch (yy_act)
 	{ /* beginning of action switch */
-			case 0: /* must back up */
-			/* undo the effects of YY_DO_BEFORE_ACTION */
-			*yy_cp = yy_hold_char;
-			yy_cp = yy_last_accepting_cpos;
-			yy_current_state = yy_last_accepting_state;
-			goto yy_find_action;
-
 case 1:
 YY_RULE_SETUP
-#line 71 ".\\lexxer.l"
-{ comment(); }
+#line 75 "lexxer.l"
+{ comment(yyscanner); }
 	YY_BREAK
 case 2:
 YY_RULE_SETUP
-#line 72 ".\\lexxer.l"
-{ cppcomment(); }
+#line 76 "lexxer.l"
+{ cppcomment(yyscanner); }
 	YY_BREAK
 case 3:
 YY_RULE_SETUP
-#line 74 ".\\lexxer.l"
-{ count(); return(ID); }
+#line 78 "lexxer.l"
+{ count(yyscanner); yylval->i = intconst(yytext); return(INT); }
 	YY_BREAK
 case 4:
 YY_RULE_SETUP
-#line 76 ".\\lexxer.l"
-{ count(); yylval.i = intconst(); return(INT); }
+#line 79 "lexxer.l"
+{ count(yyscanner); yylval->i = intconst(yytext); return(INT); }
 	YY_BREAK
 case 5:
 YY_RULE_SETUP
-#line 77 ".\\lexxer.l"
-{ count(); yylval.i = intconst(); return(INT); }
+#line 80 "lexxer.l"
+{ count(yyscanner); yylval->i = intconst(yytext); return(INT); }
 	YY_BREAK
 case 6:
 YY_RULE_SETUP
-#line 78 ".\\lexxer.l"
-{ count(); yylval.i = intconst(); return(INT); }
+#line 81 "lexxer.l"
+{ count(yyscanner); yylval->i = charconst(yytext); return(INT); }
 	YY_BREAK
 case 7:
 YY_RULE_SETUP
-#line 79 ".\\lexxer.l"
-{ count(); yylval.i = charconst(); return(INT); }
+#line 83 "lexxer.l"
+{ count(yyscanner); yylval->f = floatconst(yytext); return(FLOAT); }
 	YY_BREAK
 case 8:
 YY_RULE_SETUP
-#line 81 ".\\lexxer.l"
-{ count(); yylval.f = floatconst(); return(FLOAT); }
+#line 84 "lexxer.l"
+{ count(yyscanner); yylval->f = floatconst(yytext); return(FLOAT); }
 	YY_BREAK
 case 9:
 YY_RULE_SETUP
-#line 82 ".\\lexxer.l"
-{ count(); yylval.f = floatconst(); return(FLOAT); }
+#line 85 "lexxer.l"
+{ count(yyscanner); yylval->f = floatconst(yytext); return(FLOAT); }
 	YY_BREAK
 case 10:
 YY_RULE_SETUP
-#line 83 ".\\lexxer.l"
-{ count(); yylval.f = floatconst(); return(FLOAT); }
+#line 87 "lexxer.l"
+{ count(yyscanner); yylval->s = stringconst(yytext, yyleng); return(STRING); }
 	YY_BREAK
 case 11:
 YY_RULE_SETUP
-#line 85 ".\\lexxer.l"
-{ count(); yylval.s = stringconst(); return(STRING); }
+#line 89 "lexxer.l"
+{ count(yyscanner); return(LOAD); }
 	YY_BREAK
 case 12:
 YY_RULE_SETUP
-#line 87 ".\\lexxer.l"
-{ count(); return(LOAD); }
+#line 90 "lexxer.l"
+{ count(yyscanner); return(CONFONT); }
 	YY_BREAK
 case 13:
 YY_RULE_SETUP
-#line 88 ".\\lexxer.l"
-{ count(); return(CONFONT); }
+#line 91 "lexxer.l"
+{ count(yyscanner); return(FONT); }
 	YY_BREAK
 case 14:
 YY_RULE_SETUP
-#line 89 ".\\lexxer.l"
-{ count(); return(FONT); }
+#line 92 "lexxer.l"
+{ count(yyscanner); return(XHAIR); }
 	YY_BREAK
 case 15:
 YY_RULE_SETUP
-#line 90 ".\\lexxer.l"
-{ count(); return(XHAIR); }
+#line 93 "lexxer.l"
+{ count(yyscanner); return(IMAGE); }
 	YY_BREAK
 case 16:
 YY_RULE_SETUP
-#line 91 ".\\lexxer.l"
-{ count(); return(IMAGE); }
+#line 94 "lexxer.l"
+{ count(yyscanner); return(SHADING); }
 	YY_BREAK
 case 17:
 YY_RULE_SETUP
-#line 92 ".\\lexxer.l"
-{ count(); return(SHADING); }
+#line 95 "lexxer.l"
+{ count(yyscanner); return(NORMAL); }
 	YY_BREAK
 case 18:
 YY_RULE_SETUP
-#line 93 ".\\lexxer.l"
-{ count(); return(NORMAL); }
+#line 96 "lexxer.l"
+{ count(yyscanner); return(CONSOLE); }
 	YY_BREAK
 case 19:
 YY_RULE_SETUP
-#line 94 ".\\lexxer.l"
-{ count(); return(CONSOLE); }
+#line 97 "lexxer.l"
+{ count(yyscanner); return(TRANSPARENT); }
 	YY_BREAK
 case 20:
 YY_RULE_SETUP
-#line 95 ".\\lexxer.l"
-{ count(); return(TRANSPARENT); }
+#line 98 "lexxer.l"
+{ count(yyscanner); return(ORIGIN); }
 	YY_BREAK
 case 21:
 YY_RULE_SETUP
-#line 96 ".\\lexxer.l"
-{ count(); return(ORIGIN); }
+#line 99 "lexxer.l"
+{ count(yyscanner); return(FOREACH); }
 	YY_BREAK
 case 22:
 YY_RULE_SETUP
-#line 98 ".\\lexxer.l"
-{ count(); return(ELLIPSIS); }
+#line 100 "lexxer.l"
+{ count(yyscanner); return(AS); }
 	YY_BREAK
 case 23:
 YY_RULE_SETUP
-#line 99 ".\\lexxer.l"
-{ count(); return(RIGHT_ASSIGN); }
+#line 102 "lexxer.l"
+{ count(yyscanner); return(ID); }
 	YY_BREAK
 case 24:
 YY_RULE_SETUP
-#line 100 ".\\lexxer.l"
-{ count(); return(LEFT_ASSIGN); }
+#line 103 "lexxer.l"
+{ count(yyscanner); yylval->s = strdup(yytext); return(VARIABLE); }
 	YY_BREAK
 case 25:
 YY_RULE_SETUP
-#line 101 ".\\lexxer.l"
-{ count(); return(ADD_ASSIGN); }
+#line 105 "lexxer.l"
+{ count(yyscanner); return(ELLIPSIS); }
 	YY_BREAK
 case 26:
 YY_RULE_SETUP
-#line 102 ".\\lexxer.l"
-{ count(); return(SUB_ASSIGN); }
+#line 106 "lexxer.l"
+{ count(yyscanner); return(RIGHT_ASSIGN); }
 	YY_BREAK
 case 27:
 YY_RULE_SETUP
-#line 103 ".\\lexxer.l"
-{ count(); return(MUL_ASSIGN); }
+#line 107 "lexxer.l"
+{ count(yyscanner); return(LEFT_ASSIGN); }
 	YY_BREAK
 case 28:
 YY_RULE_SETUP
-#line 104 ".\\lexxer.l"
-{ count(); return(DIV_ASSIGN); }
+#line 108 "lexxer.l"
+{ count(yyscanner); return(ADD_ASSIGN); }
 	YY_BREAK
 case 29:
 YY_RULE_SETUP
-#line 105 ".\\lexxer.l"
-{ count(); return(MOD_ASSIGN); }
+#line 109 "lexxer.l"
+{ count(yyscanner); return(SUB_ASSIGN); }
 	YY_BREAK
 case 30:
 YY_RULE_SETUP
-#line 106 ".\\lexxer.l"
-{ count(); return(AND_ASSIGN); }
+#line 110 "lexxer.l"
+{ count(yyscanner); return(MUL_ASSIGN); }
 	YY_BREAK
 case 31:
 YY_RULE_SETUP
-#line 107 ".\\lexxer.l"
-{ count(); return(XOR_ASSIGN); }
+#line 111 "lexxer.l"
+{ count(yyscanner); return(DIV_ASSIGN); }
 	YY_BREAK
 case 32:
 YY_RULE_SETUP
-#line 108 ".\\lexxer.l"
-{ count(); return(OR_ASSIGN); }
+#line 112 "lexxer.l"
+{ count(yyscanner); return(MOD_ASSIGN); }
 	YY_BREAK
 case 33:
 YY_RULE_SETUP
-#line 109 ".\\lexxer.l"
-{ count(); return(RIGHT_OP); }
+#line 113 "lexxer.l"
+{ count(yyscanner); return(AND_ASSIGN); }
 	YY_BREAK
 case 34:
 YY_RULE_SETUP
-#line 110 ".\\lexxer.l"
-{ count(); return(LEFT_OP); }
+#line 114 "lexxer.l"
+{ count(yyscanner); return(XOR_ASSIGN); }
 	YY_BREAK
 case 35:
 YY_RULE_SETUP
-#line 111 ".\\lexxer.l"
-{ count(); return(INC_OP); }
+#line 115 "lexxer.l"
+{ count(yyscanner); return(OR_ASSIGN); }
 	YY_BREAK
 case 36:
 YY_RULE_SETUP
-#line 112 ".\\lexxer.l"
-{ count(); return(DEC_OP); }
+#line 116 "lexxer.l"
+{ count(yyscanner); return(RIGHT_OP); }
 	YY_BREAK
 case 37:
 YY_RULE_SETUP
-#line 113 ".\\lexxer.l"
-{ count(); return(PTR_OP); }
+#line 117 "lexxer.l"
+{ count(yyscanner); return(LEFT_OP); }
 	YY_BREAK
 case 38:
 YY_RULE_SETUP
-#line 114 ".\\lexxer.l"
-{ count(); return(AND_OP); }
+#line 118 "lexxer.l"
+{ count(yyscanner); return(INC_OP); }
 	YY_BREAK
 case 39:
 YY_RULE_SETUP
-#line 115 ".\\lexxer.l"
-{ count(); return(OR_OP); }
+#line 119 "lexxer.l"
+{ count(yyscanner); return(DEC_OP); }
 	YY_BREAK
 case 40:
 YY_RULE_SETUP
-#line 116 ".\\lexxer.l"
-{ count(); return(LE_OP); }
+#line 120 "lexxer.l"
+{ count(yyscanner); return(PTR_OP); }
 	YY_BREAK
 case 41:
 YY_RULE_SETUP
-#line 117 ".\\lexxer.l"
-{ count(); return(GE_OP); }
+#line 121 "lexxer.l"
+{ count(yyscanner); return(AND_OP); }
 	YY_BREAK
 case 42:
 YY_RULE_SETUP
-#line 118 ".\\lexxer.l"
-{ count(); return(EQ_OP); }
+#line 122 "lexxer.l"
+{ count(yyscanner); return(OR_OP); }
 	YY_BREAK
 case 43:
 YY_RULE_SETUP
-#line 119 ".\\lexxer.l"
-{ count(); return(NE_OP); }
+#line 123 "lexxer.l"
+{ count(yyscanner); return(LE_OP); }
 	YY_BREAK
 case 44:
 YY_RULE_SETUP
-#line 120 ".\\lexxer.l"
-{ count(); return(yytext[0]); }
+#line 124 "lexxer.l"
+{ count(yyscanner); return(GE_OP); }
 	YY_BREAK
 case 45:
 YY_RULE_SETUP
-#line 122 ".\\lexxer.l"
-{ count(); }
+#line 125 "lexxer.l"
+{ count(yyscanner); return(EQ_OP); }
 	YY_BREAK
 case 46:
 YY_RULE_SETUP
-#line 123 ".\\lexxer.l"
-{ /* ignore bad characters */ }
+#line 126 "lexxer.l"
+{ count(yyscanner); return(NE_OP); }
 	YY_BREAK
 case 47:
 YY_RULE_SETUP
-#line 125 ".\\lexxer.l"
-YY_FATAL_ERROR( "flex scanner jammed" );
+#line 127 "lexxer.l"
+{ count(yyscanner); return(yytext[0]); }
 	YY_BREAK
-#line 1009 "lexxer.c"
-case YY_STATE_EOF(INITIAL):
-	yyterminate();
-
-	case YY_END_OF_BUFFER:
-		{
-		/* Amount of text matched not including the EOB char. */
-		int yy_amount_of_matched_text = (int) (yy_cp - yytext_ptr) - 1;
-
-		/* Undo the effects of YY_DO_BEFORE_ACTION. */
-		*yy_cp = yy_hold_char;
-		YY_RESTORE_YY_MORE_OFFSET
-
-		if ( yy_current_buffer->yy_buffer_status == YY_BUFFER_NEW )
-			{
-			/* We're scanning a new file or input source.  It's
-			 * possible that this happened because the user
-			 * just pointed yyin at a new source and called
-			 * yylex().  If so, then we have to assure
-			 * consistency between yy_current_buffer and our
-			 * globals.  Here is the right place to do so, because
-			 * this is the first action (other than possibly a
-			 * back-up) that will match for the new input source.
-			 */
-			yy_n_chars = yy_current_buffer->yy_n_chars;
-			yy_current_buffer->yy_input_file = yyin;
-			yy_current_buffer->yy_buffer_status = YY_BUFFER_NORMAL;
-			}
-
-		/* Note that here we test for yy_c_buf_p "<=" to the position
-		 * of the first EOB in the buffer, since yy_c_buf_p will
-		 * already have been incremented past the NUL character
-		 * (since all states make transitions on EOB to the
-		 * end-of-buffer state).  Contrast this with the test
-		 * in input().
-		 */
-		if ( yy_c_buf_p <= &yy_current_buffer->yy_ch_buf[yy_n_chars] )
-			{ /* This was really a NUL. */
-			yy_state_type yy_next_state;
-
-			yy_c_buf_p = yytext_ptr + yy_amount_of_matched_text;
-
-			yy_current_state = yy_get_previous_state();
-
-			/* Okay, we're now positioned to make the NUL
-			 * transition.  We couldn't have
-			 * yy_get_previous_state() go ahead and do it
-			 * for us because it doesn't know how to deal
-			 * with the possibility of jamming (and we don't
-			 * want to build jamming into it because then it
-			 * will run more slowly).
-			 */
-
-			yy_next_state = yy_try_NUL_trans( yy_current_state );
-
-			yy_bp = yytext_ptr + YY_MORE_ADJ;
-
-			if ( yy_next_state )
-				{
-				/* Consume the NUL. */
-				yy_cp = ++yy_c_buf_p;
-				yy_current_state = yy_next_state;
-				goto yy_match;
-				}
-
-			else
-				{
-				yy_cp = yy_c_buf_p;
-				goto yy_find_action;
-				}
-			}
-
-		else switch ( yy_get_next_buffer() )
-			{
-			case EOB_ACT_END_OF_FILE:
-				{
-				yy_did_buffer_switch_on_eof = 0;
-
-				if ( yywrap() )
-					{
-					/* Note: because we've taken care in
-					 * yy_get_next_buffer() to have set up
-					 * yytext, we can now set up
-					 * yy_c_buf_p so that if some total
-					 * hoser (like flex itself) wants to
-					 * call the scanner after we return the
-					 * YY_NULL, it'll still work - another
-					 * YY_NULL will get returned.
-					 */
-					yy_c_buf_p = yytext_ptr + YY_MORE_ADJ;
-
-					yy_act = YY_STATE_EOF(YY_START);
-					goto do_action;
-					}
-
-				else
-					{
-					if ( ! yy_did_buffer_switch_on_eof )
-						YY_NEW_FILE;
-					}
-				break;
-				}
-
-			case EOB_ACT_CONTINUE_SCAN:
-				yy_c_buf_p =
-					yytext_ptr + yy_amount_of_matched_text;
-
-				yy_current_state = yy_get_previous_state();
-
-				yy_cp = yy_c_buf_p;
-				yy_bp = yytext_ptr + YY_MORE_ADJ;
-				goto yy_match;
-
-			case EOB_ACT_LAST_MATCH:
-				yy_c_buf_p =
-				&yy_current_buffer->yy_ch_buf[yy_n_chars];
-
-				yy_current_state = yy_get_previous_state();
-
-				yy_cp = yy_c_buf_p;
-				yy_bp = yytext_ptr + YY_MORE_ADJ;
-				goto yy_find_action;
-			}
-		break;
-		}
-
+case 48:
+YY_RULE_SETUP
+#line 129 "lexxer.l"
+{ count(yyscanner); }
+	YY_BREAK
+case 49:
+YY_RULE_SETUP
+#line 130 "lexxer.l"
+{ count(yyscanner); /* ignore bad characters */ }
+	YY_BREAK
+#line 1932 "lexxer.c"
 	default:
-		YY_FATAL_ERROR(
-			"fatal flex scanner internal error--no action found" );
+		YY_FATAL_ERROR ("fatal flex scanner internal error--no action found");
 	} /* end of action switch */
 		} /* end of scanning one token */
-	} /* end of yylex */
-
+} /* end of yylex */
 
 /* yy_get_next_buffer - try to read in a new buffer
  *
- * Returns a code representing an action:
- *	EOB_ACT_LAST_MATCH -
- *	EOB_ACT_CONTINUE_SCAN - continue scanning from current position
- *	EOB_ACT_END_OF_FILE - end of file
- */
-
-static int yy_get_next_buffer()
-	{
-	register char *dest = yy_current_buffer->yy_ch_buf;
-	register char *source = yytext_ptr;
-	register int number_to_move, i;
-	int ret_val;
-
-	if ( yy_c_buf_p > &yy_current_buffer->yy_ch_buf[yy_n_chars + 1] )
-		YY_FATAL_ERROR(
-		"fatal flex scanner internal error--end of buffer missed" );
-
-	if ( yy_current_buffer->yy_fill_buffer == 0 )
-		{ /* Don't try to fill the buffer, so this is an EOF. */
-		if ( yy_c_buf_p - yytext_ptr - YY_MORE_ADJ == 1 )
-			{
-			/* We matched a single character, the EOB, so
-			 * treat this as a final EOF.
-			 */
-			return EOB_ACT_END_OF_FILE;
-			}
-
-		else
-			{
-			/* We matched some text prior to the EOB, first
-			 * process it.
-			 */
-			return EOB_ACT_LAST_MATCH;
-			}
-		}
-
-	/* Try to read more data. */
-
-	/* First move last chars to start of buffer. */
-	number_to_move = (int) (yy_c_buf_p - yytext_ptr) - 1;
-
-	for ( i = 0; i < number_to_move; ++i )
-		*(dest++) = *(source++);
-
-	if ( yy_current_buffer->yy_buffer_status == YY_BUFFER_EOF_PENDING )
-		/* don't do the read, it's not guaranteed to return an EOF,
-		 * just force an EOF
-		 */
-		yy_current_buffer->yy_n_chars = yy_n_chars = 0;
-
-	else
-		{
-		int num_to_read =
-			yy_current_buffer->yy_buf_size - number_to_move - 1;
-
-		while ( num_to_read <= 0 )
-			{ /* Not enough room in the buffer - grow it. */
-#ifdef YY_USES_REJECT
-			YY_FATAL_ERROR(
-"input buffer overflow, can't enlarge buffer because scanner uses REJECT" );
-#else
-
-			/* just a shorter name for the current buffer */
-			YY_BUFFER_STATE b = yy_current_buffer;
-
-			int yy_c_buf_p_offset =
-				(int) (yy_c_buf_p - b->yy_ch_buf);
-
-			if ( b->yy_is_our_buffer )
-				{
-				int new_size = b->yy_buf_size * 2;
-
-				if ( new_size <= 0 )
-					b->yy_buf_size += b->yy_buf_size / 8;
-				else
-					b->yy_buf_size *= 2;
-
-				b->yy_ch_buf = (char *)
-					/* Include room in for 2 EOB chars. */
-					yy_flex_realloc( (void *) b->yy_ch_buf,
-							 b->yy_buf_size + 2 );
-				}
-			else
-				/* Can't grow it, we don't own it. */
-				b->yy_ch_buf = 0;
-
-			if ( ! b->yy_ch_buf )
-				YY_FATAL_ERROR(
-				"fatal error - scanner input buffer overflow" );
-
-			yy_c_buf_p = &b->yy_ch_buf[yy_c_buf_p_offset];
-
-			num_to_read = yy_current_buffer->yy_buf_size -
-						number_to_move - 1;
-#endif
-			}
-
-		if ( num_to_read > YY_READ_BUF_SIZE )
-			num_to_read = YY_READ_BUF_SIZE;
-
-		/* Read in more data. */
-		YY_INPUT( (&yy_current_buffer->yy_ch_buf[number_to_move]),
-			yy_n_chars, num_to_read );
-
-		yy_current_buffer->yy_n_chars = yy_n_chars;
-		}
-
-	if ( yy_n_chars == 0 )
-		{
-		if ( number_to_move == YY_MORE_ADJ )
-			{
-			ret_val = EOB_ACT_END_OF_FILE;
-			yyrestart( yyin );
-			}
-
-		else
-			{
-			ret_val = EOB_ACT_LAST_MATCH;
-			yy_current_buffer->yy_buffer_status =
-				YY_BUFFER_EOF_PENDING;
-			}
-		}
-
-	else
-		ret_val = EOB_ACT_CONTINUE_SCAN;
-
-	yy_n_chars += number_to_move;
-	yy_current_buffer->yy_ch_buf[yy_n_chars] = YY_END_OF_BUFFER_CHAR;
-	yy_current_buffer->yy_ch_buf[yy_n_chars + 1] = YY_END_OF_BUFFER_CHAR;
-
-	yytext_ptr = &yy_current_buffer->yy_ch_buf[0];
-
-	return ret_val;
-	}
-
-
-/* yy_get_previous_state - get the state just before the EOB char was reached */
-
-static yy_state_type yy_get_previous_state()
-	{
-	register yy_state_type yy_current_state;
-	register char *yy_cp;
-
-	yy_current_state = yy_start;
-
-	for ( yy_cp = yytext_ptr + YY_MORE_ADJ; yy_cp < yy_c_buf_p; ++yy_cp )
-		{
-		register YY_CHAR yy_c = (*yy_cp ? yy_ec[YY_SC_TO_UI(*yy_cp)] : 1);
-		if ( yy_accept[yy_current_state] )
-			{
-			yy_last_accepting_state = yy_current_state;
-			yy_last_accepting_cpos = yy_cp;
-			}
-		while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
-			{
-			yy_current_state = (int) yy_def[yy_current_state];
-			if ( yy_current_state >= 160 )
-				yy_c = yy_meta[(unsigned int) yy_c];
-			}
-		yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
-		}
-
-	return yy_current_state;
-	}
-
-
-/* yy_try_NUL_trans - try to make a transition on the NUL character
+ * Moves the text from *bp on, which is still being matched, to the start of
+ * the buffer, making the buffer bigger if that text fills it, and reads
+ * more input after it.  *bp and *cp, and the last accepting position, are
+ * moved along with the text.
  *
- * synopsis
- *	next_state = yy_try_NUL_trans( current_state );
+ * Returns the number of characters read, which is 0 at end of file.
  */
+static int yy_get_next_buffer (char **bp, char **cp, yyscan_t yyscanner)
+{
+	struct yyguts_t *yyg = (struct yyguts_t *)yyscanner;
+	YY_BUFFER_STATE b = YY_CURRENT_BUFFER;
+	char *dest = b->yy_ch_buf;
+	int number_to_move, num_to_read, moved;
 
-#ifdef YY_USE_PROTOS
-static yy_state_type yy_try_NUL_trans( yy_state_type yy_current_state )
-#else
-static yy_state_type yy_try_NUL_trans( yy_current_state )
-yy_state_type yy_current_state;
-#endif
-	{
-	register int yy_is_jam;
-	register char *yy_cp = yy_c_buf_p;
+	if (b->yy_buffer_status == YY_BUFFER_EOF_PENDING)
+		return 0;
 
-	register YY_CHAR yy_c = 1;
-	if ( yy_accept[yy_current_state] )
+	moved = (int) (*bp - dest);
+	number_to_move = b->yy_n_chars - moved;
+	if (moved > 0)
 		{
-		yy_last_accepting_state = yy_current_state;
-		yy_last_accepting_cpos = yy_cp;
+		memmove (dest, *bp, (size_t) number_to_move);
+		*bp -= moved;
+		*cp -= moved;
+		if (yyg->yy_last_accepting_cpos != NULL)
+			yyg->yy_last_accepting_cpos -= moved;
+		b->yy_n_chars = number_to_move;
 		}
-	while ( yy_chk[yy_base[yy_current_state] + yy_c] != yy_current_state )
-		{
-		yy_current_state = (int) yy_def[yy_current_state];
-		if ( yy_current_state >= 160 )
-			yy_c = yy_meta[(unsigned int) yy_c];
-		}
-	yy_current_state = yy_nxt[yy_base[yy_current_state] + (unsigned int) yy_c];
-	yy_is_jam = (yy_current_state == 159);
-
-	return yy_is_jam ? 0 : yy_current_state;
-	}
 
-
-#ifndef YY_NO_UNPUT
-#ifdef YY_USE_PROTOS
-static void yyunput( int c, register char *yy_bp )
-#else
-static void yyunput( c, yy_bp )
-int c;
-register char *yy_bp;
-#endif
-	{
-	register char *yy_cp = yy_c_buf_p;
-
-	/* undo effects of setting up yytext */
-	*yy_cp = yy_hold_char;
-
-	if ( yy_cp < yy_current_buffer->yy_ch_buf + 2 )
-		{ /* need to shift things up to make room */
-		/* +2 for EOB chars. */
-		register int number_to_move = yy_n_chars + 2;
-		register char *dest = &yy_current_buffer->yy_ch_buf[
-					yy_current_buffer->yy_buf_size + 2];
-		register char *source =
-				&yy_current_buffer->yy_ch_buf[number_to_move];
-
-		while ( source > yy_current_buffer->yy_ch_buf )
-			*--dest = *--source;
-
-		yy_cp += (int) (dest - source);
-		yy_bp += (int) (dest - source);
-		yy_current_buffer->yy_n_chars =
-			yy_n_chars = yy_current_buffer->yy_buf_size;
-
-		if ( yy_cp < yy_current_buffer->yy_ch_buf + 2 )
-			YY_FATAL_ERROR( "flex scanner push-back overflow" );
+	num_to_read = b->yy_buf_size - number_to_move;
+	if (num_to_read <= 0)
+		{ /* Not enough room in the buffer - grow it. */
+		int new_size = b->yy_buf_size * 2;
+		int cp_offset = (int) (*cp - b->yy_ch_buf);
+		int accept_offset = yyg->yy_last_accepting_cpos != NULL ?
+			(int) (yyg->yy_last_accepting_cpos - b->yy_ch_buf) : -1;
+
+		if (!b->yy_is_our_buffer)
+			YY_FATAL_ERROR ("input buffer overflow, can't enlarge buffer because scanner uses REJECT");
+
+		/* Include room in for 2 EOB chars. */
+		b->yy_ch_buf = (char *) yyrealloc ((void *) b->yy_ch_buf,
+			(yy_size_t) (new_size + 2), yyscanner);
+		if (!b->yy_ch_buf)
+			YY_FATAL_ERROR ("fatal error - scanner input buffer overflow");
+
+		*bp = b->yy_ch_buf;
+		*cp = b->yy_ch_buf + cp_offset;
+		if (accept_offset >= 0)
+			yyg->yy_last_accepting_cpos = b->yy_ch_buf + accept_offset;
+		b->yy_buf_size = new_size;
+		num_to_read = new_size - number_to_move;
 		}
 
-	*--yy_cp = (char) c;
+	if (num_to_read > YY_READ_BUF_SIZE)
+		num_to_read = YY_READ_BUF_SIZE;
 
+	/* Read in more data. */
+	YY_INPUT ((&b->yy_ch_buf[number_to_move]), num_to_read, num_to_read);
 
-	yytext_ptr = yy_bp;
-	yy_hold_char = *yy_cp;
-	yy_c_buf_p = yy_cp;
-	}
-#endif	/* ifndef YY_NO_UNPUT */
+	if (num_to_read == 0)
+		b->yy_buffer_status = YY_BUFFER_EOF_PENDING;
+	else
+		b->yy_buffer_status = YY_BUFFER_NORMAL;
 
+	b->yy_n_chars += num_to_read;
+	b->yy_ch_buf[b->yy_n_chars] = YY_END_OF_BUFFER_CHAR;
+	b->yy_ch_buf[b->yy_n_chars + 1] = YY_END_OF_BUFFER_CHAR;
 
-#ifdef __cplusplus
-static int yyinput()
-#else
-static int input()
-#endif
-	{
-	int c;
+	return num_to_read;
+}
 
-	*yy_c_buf_p = yy_hold_char;
+#ifndef YY_NO_INPUT
 
-	if ( *yy_c_buf_p == YY_END_OF_BUFFER_CHAR )
-		{
-		/* yy_c_buf_p now points to the character we want to return.
-		 * If this occurs *before* the EOB characters, then it's a
-		 * valid NUL; if not, then we've hit the end of the buffer.
-		 */
-		if ( yy_c_buf_p < &yy_current_buffer->yy_ch_buf[yy_n_chars] )
-			/* This was really a NUL. */
-			*yy_c_buf_p = '\0';
+static int input (yyscan_t yyscanner)
+{
+	struct yyguts_t *yyg = (struct yyguts_t *)yyscanner;
+	int c;
 
-		else
-			{ /* need more input */
-			int offset = yy_c_buf_p - yytext_ptr;
-			++yy_c_buf_p;
+	*yyg->yy_c_buf_p = yyg->yy_hold_char;
 
-			switch ( yy_get_next_buffer() )
-				{
-				case EOB_ACT_LAST_MATCH:
-					/* This happens because yy_g_n_b()
-					 * sees that we've accumulated a
-					 * token and flags that we need to
-					 * try matching the token before
-					 * proceeding.  But for input(),
-					 * there's no matching to consider.
-					 * So convert the EOB_ACT_LAST_MATCH
-					 * to EOB_ACT_END_OF_FILE.
-					 */
-
-					/* Reset buffer status. */
-					yyrestart( yyin );
-
-					/* fall through */
-
-				case EOB_ACT_END_OF_FILE:
-					{
-					if ( yywrap() )
-						return EOF;
-
-					if ( ! yy_did_buffer_switch_on_eof )
-						YY_NEW_FILE;
-#ifdef __cplusplus
-					return yyinput();
-#else
-					return input();
-#endif
-					}
+	if (yyg->yy_c_buf_p == &YY_CURRENT_BUFFER->yy_ch_buf[YY_CURRENT_BUFFER->yy_n_chars])
+		{ /* need more input */
+		char *yy_bp = yyg->yy_c_buf_p, *yy_cp = yyg->yy_c_buf_p;
 
-				case EOB_ACT_CONTINUE_SCAN:
-					yy_c_buf_p = yytext_ptr + offset;
-					break;
-				}
+		yyg->yy_last_accepting_cpos = NULL;
+		if (yy_get_next_buffer (&yy_bp, &yy_cp, yyscanner) == 0)
+			{ /* end of file */
+			yyg->yy_c_buf_p = yy_cp;
+			return 0;
 			}
+		yyg->yy_c_buf_p = yy_cp;
 		}
 
-	c = *(unsigned char *) yy_c_buf_p;	/* cast for 8-bit char's */
-	*yy_c_buf_p = '\0';	/* preserve yytext */
-	yy_hold_char = *++yy_c_buf_p;
-
+	c = *(unsigned char *) yyg->yy_c_buf_p;	/* cast for 8-bit char's */
+	*yyg->yy_c_buf_p = '\0';	/* preserve yytext */
+	yyg->yy_hold_char = *++yyg->yy_c_buf_p;
 
 	return c;
-	}
+}
 
+#endif	/* ifndef YY_NO_INPUT */
 
-#ifdef YY_USE_PROTOS
-void yyrestart( FILE *input_file )
-#else
-void yyrestart( input_file )
-FILE *input_file;
-#endif
-	{
-	if ( ! yy_current_buffer )
-		yy_current_buffer = yy_create_buffer( yyin, YY_BUF_SIZE );
+/** Immediately switch to a different input stream.
+ * @param input_file A readable stream.
+ * @param yyscanner The scanner object.
+ * @note This function does not reset the start condition to @c INITIAL .
+ */
+void yyrestart (FILE *input_file, yyscan_t yyscanner)
+{
+	struct yyguts_t *yyg = (struct yyguts_t *)yyscanner;
 
-	yy_init_buffer( yy_current_buffer, input_file );
-	yy_load_buffer_state();
-	}
+	if (!YY_CURRENT_BUFFER)
+		YY_CURRENT_BUFFER = yy_create_buffer (yyin, YY_BUF_SIZE, yyscanner);
 
+	yy_init_buffer (YY_CURRENT_BUFFER, input_file, yyscanner);
+	yy_load_buffer_state (yyscanner);
+}
 
-#ifdef YY_USE_PROTOS
-void yy_switch_to_buffer( YY_BUFFER_STATE new_buffer )
-#else
-void yy_switch_to_buffer( new_buffer )
-YY_BUFFER_STATE new_buffer;
-#endif
-	{
-	if ( yy_current_buffer == new_buffer )
+/** Switch to a different input buffer.
+ * @param new_buffer The new input buffer.
+ * @param yyscanner The scanner object.
+ */
+void yy_switch_to_buffer (YY_BUFFER_STATE new_buffer, yyscan_t yyscanner)
+{
+	struct yyguts_t *yyg = (struct yyguts_t *)yyscanner;
+
+	if (YY_CURRENT_BUFFER == new_buffer)
 		return;
 
-	if ( yy_current_buffer )
+	if (YY_CURRENT_BUFFER)
 		{
 		/* Flush out information for old buffer. */
-		*yy_c_buf_p = yy_hold_char;
-		yy_current_buffer->yy_buf_pos = yy_c_buf_p;
-		yy_current_buffer->yy_n_chars = yy_n_chars;
+		*yyg->yy_c_buf_p = yyg->yy_hold_char;
+		YY_CURRENT_BUFFER->yy_buf_pos = yyg->yy_c_buf_p;
 		}
 
-	yy_current_buffer = new_buffer;
-	yy_load_buffer_state();
-
-	/* We don't actually know whether we did this switch during
-	 * EOF (yywrap()) processing, but the only time this flag
-	 * is looked at is after yywrap() is called, so it's safe
-	 * to go ahead and always set it.
-	 */
-	yy_did_buffer_switch_on_eof = 1;
-	}
-
+	YY_CURRENT_BUFFER = new_buffer;
+	yy_load_buffer_state (yyscanner);
+}
 
-#ifdef YY_USE_PROTOS
-void yy_load_buffer_state( void )
-#else
-void yy_load_buffer_state()
-#endif
-	{
-	yy_n_chars = yy_current_buffer->yy_n_chars;
-	yytext_ptr = yy_c_buf_p = yy_current_buffer->yy_buf_pos;
-	yyin = yy_current_buffer->yy_input_file;
-	yy_hold_char = *yy_c_buf_p;
-	}
+static void yy_load_buffer_state (yyscan_t yyscanner)
+{
+	struct yyguts_t *yyg = (struct yyguts_t *)yyscanner;
 
+	yyg->yy_c_buf_p = YY_CURRENT_BUFFER->yy_buf_pos;
+	yyin = YY_CURRENT_BUFFER->yy_input_file;
+	yyg->yy_hold_char = *yyg->yy_c_buf_p;
+}
 
-#ifdef YY_USE_PROTOS
-YY_BUFFER_STATE yy_create_buffer( FILE *file, int size )
-#else
-YY_BUFFER_STATE yy_create_buffer( file, size )
-FILE *file;
-int size;
-#endif
-	{
+/** Allocate and initialize an input buffer state.
+ * @param file A readable stream.
+ * @param size The character buffer size in bytes. When in doubt, use @c YY_BUF_SIZE.
+ * @param yyscanner The scanner object.
+ * @return the allocated buffer state.
+ */
+YY_BUFFER_STATE yy_create_buffer (FILE *file, int size, yyscan_t yyscanner)
+{
 	YY_BUFFER_STATE b;
 
-	b = (YY_BUFFER_STATE) yy_flex_alloc( sizeof( struct yy_buffer_state ) );
-	if ( ! b )
-		YY_FATAL_ERROR( "out of dynamic memory in yy_create_buffer()" );
+	b = (YY_BUFFER_STATE) yyalloc (sizeof (struct yy_buffer_state), yyscanner);
+	if (!b)
+		YY_FATAL_ERROR ("out of dynamic memory in yy_create_buffer()");
 
 	b->yy_buf_size = size;
 
 	/* yy_ch_buf has to be 2 characters longer than the size given because
 	 * we need to put in 2 end-of-buffer characters.
 	 */
-	b->yy_ch_buf = (char *) yy_flex_alloc( b->yy_buf_size + 2 );
-	if ( ! b->yy_ch_buf )
-		YY_FATAL_ERROR( "out of dynamic memory in yy_create_buffer()" );
+	b->yy_ch_buf = (char *) yyalloc ((yy_size_t) (b->yy_buf_size + 2), yyscanner);
+	if (!b->yy_ch_buf)
+		YY_FATAL_ERROR ("out of dynamic memory in yy_create_buffer()");
 
 	b->yy_is_our_buffer = 1;
 
-	yy_init_buffer( b, file );
+	yy_init_buffer (b, file, yyscanner);
 
 	return b;
-	}
+}
 
+/** Destroy the buffer.
+ * @param b a buffer created with yy_create_buffer()
+ * @param yyscanner The scanner object.
+ */
+void yy_delete_buffer (YY_BUFFER_STATE b, yyscan_t yyscanner)
+{
+	struct yyguts_t *yyg = (struct yyguts_t *)yyscanner;
 
-#ifdef YY_USE_PROTOS
-void yy_delete_buffer( YY_BUFFER_STATE b )
-#else
-void yy_delete_buffer( b )
-YY_BUFFER_STATE b;
-#endif
-	{
-	if ( ! b )
+	if (!b)
 		return;
 
-	if ( b == yy_current_buffer )
-		yy_current_buffer = (YY_BUFFER_STATE) 0;
-
-	if ( b->yy_is_our_buffer )
-		yy_flex_free( (void *) b->yy_ch_buf );
-
-	yy_flex_free( (void *) b );
-	}
-
-
-#ifndef YY_ALWAYS_INTERACTIVE
-#ifndef YY_NEVER_INTERACTIVE
-extern int isatty YY_PROTO(( int ));
-#endif
-#endif
+	if (b == YY_CURRENT_BUFFER) /* Not sure if we should pop here. */
+		YY_CURRENT_BUFFER = (YY_BUFFER_STATE) 0;
 
-#ifdef YY_USE_PROTOS
-void yy_init_buffer( YY_BUFFER_STATE b, FILE *file )
-#else
-void yy_init_buffer( b, file )
-YY_BUFFER_STATE b;
-FILE *file;
-#endif
+	if (b->yy_is_our_buffer)
+		yyfree ((void *) b->yy_ch_buf, yyscanner);
 
+	yyfree ((void *) b, yyscanner);
+}
 
-	{
-	yy_flush_buffer( b );
+/* Initializes or reinitializes a buffer.
+ * This function is sometimes called more than once on the same buffer,
+ * such as during a yyrestart().
+ */
+static void yy_init_buffer (YY_BUFFER_STATE b, FILE *file, yyscan_t yyscanner)
+{
+	yy_flush_buffer (b, yyscanner);
 
 	b->yy_input_file = file;
-	b->yy_fill_buffer = 1;
-
-#if YY_ALWAYS_INTERACTIVE
-	b->yy_is_interactive = 1;
-#else
-#if YY_NEVER_INTERACTIVE
-	b->yy_is_interactive = 0;
-#else
-	b->yy_is_interactive = file ? (isatty( fileno(file) ) > 0) : 0;
-#endif
-#endif
-	}
-
+}
 
-#ifdef YY_USE_PROTOS
-void yy_flush_buffer( YY_BUFFER_STATE b )
-#else
-void yy_flush_buffer( b )
-YY_BUFFER_STATE b;
-#endif
+/** Discard all buffered characters. On the next scan, YY_INPUT will be called.
+ * @param b the buffer state to be flushed, usually @c YY_CURRENT_BUFFER.
+ * @param yyscanner The scanner object.
+ */
+void yy_flush_buffer (YY_BUFFER_STATE b, yyscan_t yyscanner)
+{
+	struct yyguts_t *yyg = (struct yyguts_t *)yyscanner;
 
-	{
-	if ( ! b )
+	if (!b)
 		return;
 
 	b->yy_n_chars = 0;
@@ -1624,278 +2170,241 @@ YY_BUFFER_STATE b;
 
 	b->yy_buf_pos = &b->yy_ch_buf[0];
 
-	b->yy_at_bol = 1;
 	b->yy_buffer_status = YY_BUFFER_NEW;
 
-	if ( b == yy_current_buffer )
-		yy_load_buffer_state();
-	}
-
-
-#ifndef YY_NO_SCAN_BUFFER
-#ifdef YY_USE_PROTOS
-YY_BUFFER_STATE yy_scan_buffer( char *base, yy_size_t size )
-#else
-YY_BUFFER_STATE yy_scan_buffer( base, size )
-char *base;
-yy_size_t size;
-#endif
-	{
-	YY_BUFFER_STATE b;
-
-	if ( size < 2 ||
-	     base[size-2] != YY_END_OF_BUFFER_CHAR ||
-	     base[size-1] != YY_END_OF_BUFFER_CHAR )
-		/* They forgot to leave room for the EOB's. */
-		return 0;
-
-	b = (YY_BUFFER_STATE) yy_flex_alloc( sizeof( struct yy_buffer_state ) );
-	if ( ! b )
-		YY_FATAL_ERROR( "out of dynamic memory in yy_scan_buffer()" );
-
-	b->yy_buf_size = size - 2;	/* "- 2" to take care of EOB's */
-	b->yy_buf_pos = b->yy_ch_buf = base;
-	b->yy_is_our_buffer = 0;
-	b->yy_input_file = 0;
-	b->yy_n_chars = b->yy_buf_size;
-	b->yy_is_interactive = 0;
-	b->yy_at_bol = 1;
-	b->yy_fill_buffer = 0;
-	b->yy_buffer_status = YY_BUFFER_NEW;
-
-	yy_switch_to_buffer( b );
-
-	return b;
-	}
-#endif
-
-
-#ifndef YY_NO_SCAN_STRING
-#ifdef YY_USE_PROTOS
-YY_BUFFER_STATE yy_scan_string( yyconst char *yy_str )
-#else
-YY_BUFFER_STATE yy_scan_string( yy_str )
-yyconst char *yy_str;
-#endif
-	{
-	int len;
-	for ( len = 0; yy_str[len]; ++len )
-		;
-
-	return yy_scan_bytes( yy_str, len );
-	}
-#endif
-
+	if (b == YY_CURRENT_BUFFER)
+		yy_load_buffer_state (yyscanner);
+}
 
-#ifndef YY_NO_SCAN_BYTES
-#ifdef YY_USE_PROTOS
-YY_BUFFER_STATE yy_scan_bytes( yyconst char *bytes, int len )
-#else
-YY_BUFFER_STATE yy_scan_bytes( bytes, len )
-yyconst char *bytes;
-int len;
-#endif
-	{
+/** Setup the input buffer state to scan the given bytes. The next call to yylex() will
+ * scan from a @e copy of @a bytes.
+ * @param yybytes the byte buffer to scan
+ * @param _yybytes_len the number of bytes in the buffer pointed to by @a bytes.
+ * @param yyscanner The scanner object.
+ * @return the newly allocated buffer state object.
+ */
+YY_BUFFER_STATE yy_scan_bytes (const char *yybytes, int _yybytes_len, yyscan_t yyscanner)
+{
 	YY_BUFFER_STATE b;
 	char *buf;
 	yy_size_t n;
-	int i;
 
 	/* Get memory for full buffer, including space for trailing EOB's. */
-	n = len + 2;
-	buf = (char *) yy_flex_alloc( n );
-	if ( ! buf )
-		YY_FATAL_ERROR( "out of dynamic memory in yy_scan_bytes()" );
+	n = (yy_size_t) (_yybytes_len + 2);
+	buf = (char *) yyalloc (n, yyscanner);
+	if (!buf)
+		YY_FATAL_ERROR ("out of dynamic memory in yy_scan_bytes()");
 
-	for ( i = 0; i < len; ++i )
-		buf[i] = bytes[i];
+	b = (YY_BUFFER_STATE) yyalloc (sizeof (struct yy_buffer_state), yyscanner);
+	if (!b)
+		YY_FATAL_ERROR ("out of dynamic memory in yy_scan_bytes()");
 
-	buf[len] = buf[len+1] = YY_END_OF_BUFFER_CHAR;
+	memcpy (buf, yybytes, (size_t) _yybytes_len);
+	buf[_yybytes_len] = buf[_yybytes_len + 1] = YY_END_OF_BUFFER_CHAR;
 
-	b = yy_scan_buffer( buf, n );
-	if ( ! b )
-		YY_FATAL_ERROR( "bad buffer in yy_scan_bytes()" );
-
-	/* It's okay to grow etc. this buffer, and we should throw it
-	 * away when we're done.
-	 */
+	b->yy_buf_size = _yybytes_len;
+	b->yy_buf_pos = b->yy_ch_buf = buf;
 	b->yy_is_our_buffer = 1;
+	b->yy_input_file = NULL;
+	b->yy_n_chars = _yybytes_len;
+	b->yy_buffer_status = YY_BUFFER_EOF_PENDING;
+
+	yy_switch_to_buffer (b, yyscanner);
 
 	return b;
-	}
-#endif
+}
 
+/** Setup the input buffer state to scan a string. The next call to yylex() will
+ * scan from a @e copy of @a str.
+ * @param yystr a NUL-terminated string to scan
+ * @param yyscanner The scanner object.
+ * @return the newly allocated buffer state object.
+ */
+YY_BUFFER_STATE yy_scan_string (const char *yystr, yyscan_t yyscanner)
+{
+	return yy_scan_bytes (yystr, (int) strlen (yystr), yyscanner);
+}
 
-#ifndef YY_NO_PUSH_STATE
-#ifdef YY_USE_PROTOS
-static void yy_push_state( int new_state )
-#else
-static void yy_push_state( new_state )
-int new_state;
+#ifndef YY_EXIT_FAILURE
+#define YY_EXIT_FAILURE 2
 #endif
-	{
-	if ( yy_start_stack_ptr >= yy_start_stack_depth )
-		{
-		yy_size_t new_size;
 
-		yy_start_stack_depth += YY_START_STACK_INCR;
-		new_size = yy_start_stack_depth * sizeof( int );
-
-		if ( ! yy_start_stack )
-			yy_start_stack = (int *) yy_flex_alloc( new_size );
+static void yy_fatal_error (const char *msg, yyscan_t yyscanner)
+{
+	(void) yyscanner;
+	fprintf (stderr, "%s\n", msg);
+	exit (YY_EXIT_FAILURE);
+}
 
-		else
-			yy_start_stack = (int *) yy_flex_realloc(
-					(void *) yy_start_stack, new_size );
+/* Accessor  methods (get/set functions) to struct members. */
 
-		if ( ! yy_start_stack )
-			YY_FATAL_ERROR(
-			"out of memory expanding start-condition stack" );
-		}
+/** Get the user-defined data for this scanner.
+ * @param yyscanner The scanner object.
+ */
+YY_EXTRA_TYPE yyget_extra (yyscan_t yyscanner)
+{
+	struct yyguts_t *yyg = (struct yyguts_t *)yyscanner;
+	return yyextra;
+}
 
-	yy_start_stack[yy_start_stack_ptr++] = YY_START;
+/** Get the input stream.
+ * @param yyscanner The scanner object.
+ */
+FILE *yyget_in (yyscan_t yyscanner)
+{
+	struct yyguts_t *yyg = (struct yyguts_t *)yyscanner;
+	return yyin;
+}
 
-	BEGIN(new_state);
-	}
-#endif
+/** Get the output stream.
+ * @param yyscanner The scanner object.
+ */
+FILE *yyget_out (yyscan_t yyscanner)
+{
+	struct yyguts_t *yyg = (struct yyguts_t *)yyscanner;
+	return yyout;
+}
 
+/** Get the length of the current token.
+ * @param yyscanner The scanner object.
+ */
+int yyget_leng (yyscan_t yyscanner)
+{
+	struct yyguts_t *yyg = (struct yyguts_t *)yyscanner;
+	return yyleng;
+}
 
-#ifndef YY_NO_POP_STATE
-static void yy_pop_state()
-	{
-	if ( --yy_start_stack_ptr < 0 )
-		YY_FATAL_ERROR( "start-condition stack underflow" );
+/** Get the current token.
+ * @param yyscanner The scanner object.
+ */
+char *yyget_text (yyscan_t yyscanner)
+{
+	struct yyguts_t *yyg = (struct yyguts_t *)yyscanner;
+	return yytext;
+}
 
-	BEGIN(yy_start_stack[yy_start_stack_ptr]);
-	}
-#endif
+/** Set the user-defined data. This data is never touched by the scanner.
+ * @param user_defined The data to be associated with this scanner.
+ * @param yyscanner The scanner object.
+ */
+void yyset_extra (YY_EXTRA_TYPE user_defined, yyscan_t yyscanner)
+{
+	struct yyguts_t *yyg = (struct yyguts_t *)yyscanner;
+	yyextra = user_defined;
+}
 
+/** Set the input stream. This does not discard the current
+ * input buffer.
+ * @param _in_str A readable stream.
+ * @param yyscanner The scanner object.
+ * @see yy_switch_to_buffer
+ */
+void yyset_in (FILE *_in_str, yyscan_t yyscanner)
+{
+	struct yyguts_t *yyg = (struct yyguts_t *)yyscanner;
+	yyin = _in_str;
+}
 
-#ifndef YY_NO_TOP_STATE
-static int yy_top_state()
-	{
-	return yy_start_stack[yy_start_stack_ptr - 1];
-	}
-#endif
+void yyset_out (FILE *_out_str, yyscan_t yyscanner)
+{
+	struct yyguts_t *yyg = (struct yyguts_t *)yyscanner;
+	yyout = _out_str;
+}
 
-#ifndef YY_EXIT_FAILURE
-#define YY_EXIT_FAILURE 2
-#endif
+/** Get the semantic value of the current token.
+ * @param yyscanner The scanner object.
+ */
+YYSTYPE *yyget_lval (yyscan_t yyscanner)
+{
+	struct yyguts_t *yyg = (struct yyguts_t *)yyscanner;
+	return yylval;
+}
 
-#ifdef YY_USE_PROTOS
-static void yy_fatal_error( yyconst char msg[] )
-#else
-static void yy_fatal_error( msg )
-char msg[];
-#endif
-	{
-	(void) fprintf( stderr, "%s\n", msg );
-	exit( YY_EXIT_FAILURE );
-	}
+void yyset_lval (YYSTYPE *yylval_param, yyscan_t yyscanner)
+{
+	struct yyguts_t *yyg = (struct yyguts_t *)yyscanner;
+	yylval = yylval_param;
+}
 
+/* User-visible API */
 
+/* yylex_init is special because it creates the scanner itself, so it is
+ * the ONLY reentrant function that doesn't take the scanner as the last argument.
+ * That's why we explicitly handle the declaration, instead of using our macros.
+ */
+int yylex_init (yyscan_t *ptr_yy_globals)
+{
+	return yylex_init_extra (NULL, ptr_yy_globals);
+}
 
-/* Redefine yyless() so it works in section 3 code. */
+/* yylex_init_extra has the same functionality as yylex_init, but follows the
+ * convention of taking the scanner as the last argument. Note however, that
+ * this is a *pointer* to a scanner, as it will be allocated by this call (and
+ * is the reason, too, why this function also must handle its own declaration).
+ * The user defined value in the first argument will be available to yyalloc in
+ * the yyextra field.
+ */
+int yylex_init_extra (YY_EXTRA_TYPE yy_user_defined, yyscan_t *ptr_yy_globals)
+{
+	if (ptr_yy_globals == NULL)
+		{
+		errno = EINVAL;
+		return 1;
+		}
 
-#undef yyless
-#define yyless(n) \
-	do \
-		{ \
-		/* Undo effects of setting up yytext. */ \
-		yytext[yyleng] = yy_hold_char; \
-		yy_c_buf_p = yytext + n; \
-		yy_hold_char = *yy_c_buf_p; \
-		*yy_c_buf_p = '\0'; \
-		yyleng = n; \
-		} \
-	while ( 0 )
-
-
-/* Internal utility routines. */
-
-#ifndef yytext_ptr
-#ifdef YY_USE_PROTOS
-static void yy_flex_strncpy( char *s1, yyconst char *s2, int n )
-#else
-static void yy_flex_strncpy( s1, s2, n )
-char *s1;
-yyconst char *s2;
-int n;
-#endif
-	{
-	register int i;
-	for ( i = 0; i < n; ++i )
-		s1[i] = s2[i];
-	}
-#endif
+	*ptr_yy_globals = (yyscan_t) yyalloc (sizeof (struct yyguts_t), NULL);
 
-#ifdef YY_NEED_STRLEN
-#ifdef YY_USE_PROTOS
-static int yy_flex_strlen( yyconst char *s )
-#else
-static int yy_flex_strlen( s )
-yyconst char *s;
-#endif
-	{
-	register int n;
-	for ( n = 0; s[n]; ++n )
-		;
+	if (*ptr_yy_globals == NULL)
+		{
+		errno = ENOMEM;
+		return 1;
+		}
 
-	return n;
-	}
-#endif
+	/* By setting to 0xAA, we expose bugs in
+	yy_init_globals. Leave at 0x00 for releases. */
+	memset (*ptr_yy_globals, 0x00, sizeof (struct yyguts_t));
 
+	yyset_extra (yy_user_defined, *ptr_yy_globals);
 
-#ifdef YY_USE_PROTOS
-static void *yy_flex_alloc( yy_size_t size )
-#else
-static void *yy_flex_alloc( size )
-yy_size_t size;
-#endif
-	{
-	return (void *) malloc( size );
-	}
+	return 0;
+}
 
-#ifdef YY_USE_PROTOS
-static void *yy_flex_realloc( void *ptr, yy_size_t size )
-#else
-static void *yy_flex_realloc( ptr, size )
-void *ptr;
-yy_size_t size;
-#endif
-	{
-	/* The cast to (char *) in the following accommodates both
-	 * implementations that use char* generic pointers, and those
-	 * that use void* generic pointers.  It works with the latter
-	 * because both ANSI C and C++ allow castless assignment from
-	 * any pointer type to void*, and deal with argument conversions
-	 * as though doing an assignment.
-	 */
-	return (void *) realloc( (char *) ptr, size );
-	}
+/* yylex_destroy is for both reentrant and non-reentrant scanners. */
+int yylex_destroy (yyscan_t yyscanner)
+{
+	struct yyguts_t *yyg = (struct yyguts_t *)yyscanner;
 
-#ifdef YY_USE_PROTOS
-static void yy_flex_free( void *ptr )
-#else
-static void yy_flex_free( ptr )
-void *ptr;
-#endif
-	{
-	free( ptr );
-	}
+	yy_delete_buffer (YY_CURRENT_BUFFER, yyscanner);
 
-#if YY_MAIN
-int main()
-	{
-	yylex();
+	/* Destroy the main struct (reentrant only). */
+	yyfree (yyscanner, yyscanner);
+	yyscanner = NULL;
 	return 0;
-	}
-#endif
-#line 125 ".\\lexxer.l"
+}
+
+void *yyalloc (yy_size_t size, yyscan_t yyscanner)
+{
+	(void) yyscanner;
+	return malloc (size);
+}
+
+void *yyrealloc (void *ptr, yy_size_t size, yyscan_t yyscanner)
+{
+	(void) yyscanner;
+	return realloc (ptr, size);
+}
+
+void yyfree (void *ptr, yyscan_t yyscanner)
+{
+	(void) yyscanner;
+	free ((char *) ptr);	/* see yyrealloc() for (char *) cast */
+}
 
+#line 133 "lexxer.l"
 
-static void comment (void)
+static void comment (yyscan_t yyscanner)
 {
+	ParseContext *context = yyget_extra (yyscanner);
 	char c, c1;
 
 	c1 = 0;
@@ -1905,62 +2414,65 @@ static void comment (void)
 		do
 		{
 			if (c == '\n')
-				column = 0, lineno++;
+				context->Column = 0, context->Line++;
 			else if (c == '\t')
-				column += 8 - (column & 7);
+				context->Column += 8 - (context->Column & 7);
 			else if (c)
-				column++;
-		} while ((c = input()) != '*' && c != 0);
-	} while ((c1 = input()) != '/' && c != 0);
+				context->Column++;
+		} while ((c = input(yyscanner)) != '*' && c != 0);
+	} while ((c1 = input(yyscanner)) != '/' && c != 0);
 }
 
-static void cppcomment (void)
+static void cppcomment (yyscan_t yyscanner)
 {
+	ParseContext *context = yyget_extra (yyscanner);
 	char c;
 
-	while ((c = input()) != '\n' && c != 0)
+	while ((c = input(yyscanner)) != '\n' && c != 0)
 		;
 
-	column = 0;
-	lineno++;
+	context->Column = 0;
+	context->Line++;
 }
 
-static void count(void)
+static void count(yyscan_t yyscanner)
 {
+	ParseContext *context = yyget_extra (yyscanner);
+	const char *text = yyget_text (yyscanner);
 	int i;
 
-	for (i = 0; yytext[i] != '\0'; ++i)
+	for (i = 0; text[i] != '\0'; ++i)
 	{
-		if (yytext[i] == '\n')
-			column = 0, lineno++;
-		else if (yytext[i] == '\t')
-			column += 8 - (column & 7);
+		if (text[i] == '\n')
+			context->Column = 0, context->Line++;
+		else if (text[i] == '\t')
+			context->Column += 8 - (context->Column & 7);
 		else
-			column++;
+			context->Column++;
 	}
 }
 
-static int intconst(void)
+static int intconst(const char *text)
 {
-	return strtol (yytext, NULL, 0);
+	return strtol (text, NULL, 0);
 }
 
-static double floatconst(void)
+static double floatconst(const char *text)
 {
-	return strtod (yytext, NULL);
+	return strtod (text, NULL);
 }
 
-static char *stringconst(void)
+static char *stringconst(char *text, int len)
 {
-	yytext[yyleng-1] = 0;
-	return strdup (yytext[0] != '\"' ? yytext+2 : yytext+1);
+	text[len-1] = 0;
+	return strdup (text[0] != '\"' ? text+2 : text+1);
 }
 
-static int charconst(void)
+static int charconst(const char *text)
 {
-	if (yytext[1] == '\\')
+	if (text[1] == '\\')
 	{
-		switch (yytext[2])
+		switch (text[2])
 		{
 		case 'a': return '\a';
 		case 'b': return '\b';
@@ -1969,8 +2481,8 @@ static int charconst(void)
 		case 'r': return '\r';
 		case 't': return '\t';
 		case 'v': return '\v';
-		default:  return yytext[2];
+		default:  return text[2];
 		}
 	}
-	return yytext[1];
+	return text[1];
 }
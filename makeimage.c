@@ -45,7 +45,7 @@ int WriteImage (const char *name, UBYTE *data, int width, int height,
 	f = fopen (name, "wb");
 	if (f == NULL)
 	{
-		printf ("could not open %s\n", name);
+		Printf ("could not open %s\n", name);
 		return 1;
 	}
 
@@ -73,14 +73,14 @@ int WriteImage (const char *name, UBYTE *data, int width, int height,
 
 	if (cprsize > srcwidth * height)
 	{
-		printf ("compressed to %d (%d larger than uncompressed)\n",
+		Printf ("compressed to %d (%d larger than uncompressed)\n",
 			cprsize, cprsize - srcwidth * height);
 		fclose (f);
 
 		f = fopen (name, "wb");
 		if (f != NULL)
 		{
-			printf ("resaving as uncompressed\n");
+			Printf ("resaving as uncompressed\n");
 			header.Compression = 0;
 			fwrite (&header, 1, sizeof(header), f);
 			data_p = data;
@@ -93,12 +93,12 @@ int WriteImage (const char *name, UBYTE *data, int width, int height,
 		}
 		else
 		{
-			printf ("could not reopen to write uncompressed version\n");
+			Printf ("could not reopen to write uncompressed version\n");
 		}
 	}
 	else
 	{
-		printf ("compressed to %d (%d smaller than uncompressed)\n",
+		Printf ("compressed to %d (%d smaller than uncompressed)\n",
 			cprsize, srcwidth * height - cprsize);
 	}
 
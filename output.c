@@ -0,0 +1,228 @@
+/*
+** output.c
+** Messages that can be held back and printed in order.
+**
+**---------------------------------------------------------------------------
+** Copyright 2001 Randy Heit
+** All rights reserved.
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions
+** are met:
+**
+** 1. Redistributions of source code must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. The name of the author may not be used to endorse or promote products
+**    derived from this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+** IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+** OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+** IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+** NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+** DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+** THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+** THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**---------------------------------------------------------------------------
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include "threads.h"
+#include "output.h"
+
+#ifdef _MSC_VER
+#define vsnprintf _vsnprintf
+#endif
+
+// Each message in a log is a byte saying which stream it goes to,
+// followed by the text and a terminating null.
+struct OutputLog
+{
+	char *Text;
+	int Size, Alloc;
+	OutputLog *Outer;	// the log that was current before this one
+};
+
+static THREAD_LOCAL OutputLog *CurrentLog;
+
+static void VPrint (FILE *stream, const char *fmt, va_list argptr)
+{
+	char buf[1024];
+	int len;
+
+	if (CurrentLog == NULL)
+	{
+		vfprintf (stream, fmt, argptr);
+		return;
+	}
+
+	len = vsnprintf (buf, sizeof(buf), fmt, argptr);
+	if (len < 0 || len >= (int)sizeof(buf))
+	{
+		len = sizeof(buf) - 1;
+		buf[len] = 0;
+	}
+	if (CurrentLog->Size + len + 2 > CurrentLog->Alloc)
+	{
+		int alloc = CurrentLog->Alloc ? CurrentLog->Alloc * 2 : 1024;
+		char *text;
+
+		while (alloc < CurrentLog->Size + len + 2)
+			alloc *= 2;
+		text = realloc (CurrentLog->Text, alloc);
+		if (text == NULL)
+		{ // Better to print it out of order than not at all
+			fputs (buf, stream);
+			return;
+		}
+		CurrentLog->Text = text;
+		CurrentLog->Alloc = alloc;
+	}
+	CurrentLog->Text[CurrentLog->Size++] = stream == stderr ? 2 : 1;
+	memcpy (CurrentLog->Text + CurrentLog->Size, buf, len + 1);
+	CurrentLog->Size += len + 1;
+}
+
+int Printf (const char *fmt, ...)
+{
+	va_list argptr;
+
+	va_start (argptr, fmt);
+	VPrint (stdout, fmt, argptr);
+	va_end (argptr);
+	return 0;
+}
+
+int Eprintf (const char *fmt, ...)
+{
+	va_list argptr;
+
+	va_start (argptr, fmt);
+	VPrint (stderr, fmt, argptr);
+	va_end (argptr);
+	return 0;
+}
+
+// Starts holding this thread's messages in a new log, until EndLog.
+// Logs can be nested.
+OutputLog *StartLog (void)
+{
+	OutputLog *log = calloc (1, sizeof(OutputLog));
+
+	if (log != NULL)
+	{
+		log->Outer = CurrentLog;
+		CurrentLog = log;
+	}
+	return log;
+}
+
+void EndLog (void)
+{
+	if (CurrentLog != NULL)
+	{
+		CurrentLog = CurrentLog->Outer;
+	}
+}
+
+// Calls func for each message in the log, in order.
+void WalkLog (OutputLog *log, LogFunc func, void *userdata)
+{
+	int i;
+
+	if (log == NULL)
+		return;
+
+	for (i = 0; i < log->Size; i += strlen (log->Text + i + 1) + 2)
+	{
+		func (userdata, log->Text[i] == 2 ? stderr : stdout, log->Text + i + 1);
+	}
+}
+
+void FreeLog (OutputLog *log)
+{
+	if (log != NULL)
+	{
+		free (log->Text);
+		free (log);
+	}
+}
+
+// Returns how much is in this thread's log, so CopyLog can copy what
+// is added after it. Returns -1 if there is no log.
+int LogMark (void)
+{
+	return CurrentLog != NULL ? CurrentLog->Size : -1;
+}
+
+// Returns a copy of the messages logged since mark.
+char *CopyLog (int mark, int *len)
+{
+	char *copy;
+
+	*len = 0;
+	if (mark < 0 || CurrentLog == NULL || CurrentLog->Size == mark)
+		return NULL;
+
+	copy = malloc (CurrentLog->Size - mark);
+	if (copy != NULL)
+	{
+		*len = CurrentLog->Size - mark;
+		memcpy (copy, CurrentLog->Text + mark, *len);
+	}
+	return copy;
+}
+
+// Prints messages from CopyLog again, as if they had just been printed.
+void ReplayLog (const char *text, int len)
+{
+	int i;
+
+	for (i = 0; i < len; i += strlen (text + i + 1) + 2)
+	{
+		if (text[i] == 2)
+			Eprintf ("%s", text + i + 1);
+		else
+			Printf ("%s", text + i + 1);
+	}
+}
+
+// Prints everything in the log, then frees it. If this thread has a log
+// of its own, the messages go there instead.
+void FlushLog (OutputLog *log)
+{
+	int i;
+
+	if (log == NULL)
+		return;
+
+	if (CurrentLog != NULL)
+	{
+		ReplayLog (log->Text, log->Size);
+		FreeLog (log);
+		return;
+	}
+	for (i = 0; i < log->Size; )
+	{
+		if (log->Text[i] == 2)
+		{
+			fflush (stdout);
+			fputs (log->Text + i + 1, stderr);
+		}
+		else
+		{
+			fputs (log->Text + i + 1, stdout);
+		}
+		i += strlen (log->Text + i + 1) + 2;
+	}
+	fflush (stdout);
+	FreeLog (log);
+}
@@ -0,0 +1,26 @@
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <stdio.h>
+
+/* Printf and Eprintf print to stdout and stderr. When a thread has
+ * started a log, they collect in the log instead, so that work done in
+ * parallel can still have its messages printed in a fixed order.
+ */
+typedef struct OutputLog OutputLog;
+typedef void (*LogFunc) (void *userdata, FILE *stream, const char *text);
+
+int Printf (const char *fmt, ...);
+int Eprintf (const char *fmt, ...);
+
+OutputLog *StartLog (void);
+void EndLog (void);
+void FlushLog (OutputLog *log);
+void WalkLog (OutputLog *log, LogFunc func, void *userdata);
+void FreeLog (OutputLog *log);
+
+int LogMark (void);
+char *CopyLog (int mark, int *len);
+void ReplayLog (const char *text, int len);
+
+#endif
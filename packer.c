@@ -20,6 +20,7 @@ typedef unsigned int ULONG;
 typedef signed int LONG;
 
 #include "packer.h"
+#include <stdlib.h>
 
 #define DUMP	0
 #define RUN		1
@@ -28,13 +29,12 @@ typedef signed int LONG;
 #define MaxRun	128
 #define MaxDat	128
 
-static LONG putSize;
-static char buf[256];	/* [TBD] should be 128?  on stack?*/
+/* Reads the next byte of the rectangle, moving down a row as needed. */
+#define GetByte()		(col == width ? (source += pitch, col = 0) : 0, \
+						 b = source[col++], b == from ? to : b)
+#define PutByte(c)		{ *dest++ = (c); }
 
-#define GetByte()		(*source++)
-#define PutByte(c)		{ putc (c, dest); ++putSize; }
-
-static FILE *PutDump (FILE *dest, int nn)
+static BYTE *PutDump (BYTE *dest, char *buf, int nn)
 {
 	int i;
 
@@ -44,30 +44,36 @@ static FILE *PutDump (FILE *dest, int nn)
 	return dest;
 }
 
-static FILE *PutRun (FILE *dest, int nn, int cc)
+static BYTE *PutRun (BYTE *dest, int nn, int cc)
 {
 	PutByte (-(nn-1));
 	PutByte (cc);
 	return dest;
 }
 
-#define OutDump(nn)		dest = PutDump (dest, nn)
+#define OutDump(nn)		dest = PutDump (dest, buf, nn)
 #define OutRun(nn,cc)	dest = PutRun (dest, nn, cc)
 
-/*----------- packrow --------------------------------------------------*/
-/* Given POINTERS TO POINTERS, packs one row, updating the source and
- * destination pointers.  RETURNs count of packed bytes.
+/*----------- PackRect -------------------------------------------------*/
+/* Packs a width x height rectangle whose rows are pitch bytes apart as
+ * if it were one row, changing every byte equal to from into to along
+ * the way.  RETURNs count of packed bytes.  The destination must have
+ * room for MaxPackedSize(width*height) bytes.  Keeps no state between
+ * calls, so it may be used from several threads at once.
  */
-LONG packrow (BYTE **pSource, FILE *dest, LONG rowSize)
+LONG PackRect (const BYTE *source, LONG pitch, LONG width, LONG height,
+			   BYTE from, BYTE to, BYTE *dest)
 {
-	BYTE *source;
+	BYTE *start = dest;
+	LONG rowSize = width * height;
+	LONG col = 0;
+	BYTE b;
+	char buf[256];
 	char c, lastc = '\0';
 	int mode = DUMP;
 	short nbuf = 0;				/* number of chars in buffer */
 	short rstart = 0;			/* buffer index current run starts */
 
-	source = *pSource;
-	putSize = 0;
 	buf[0] = lastc = c = GetByte();	/* so have valid lastc */
 	nbuf = 1;	rowSize--;		/* since one byte eaten. */
 
@@ -119,6 +125,51 @@ LONG packrow (BYTE **pSource, FILE *dest, LONG rowSize)
 	case DUMP: OutDump(nbuf); break;
 	case RUN: OutRun(nbuf-rstart,lastc); break;
 	}
-	*pSource = source;
+	return dest - start;
+}
+
+/*----------- PackRow --------------------------------------------------*/
+/* Given POINTERS TO POINTERS, packs one row, updating the source and
+ * destination pointers.  RETURNs count of packed bytes.  The destination
+ * must have room for MaxPackedSize(rowSize) bytes.
+ */
+LONG PackRow (BYTE **pSource, BYTE **pDest, LONG rowSize)
+{
+	LONG putSize = PackRect (*pSource, rowSize, rowSize, 1, 0, 0, *pDest);
+
+	*pSource += rowSize;
+	*pDest += putSize;
+	return putSize;
+}
+
+/*----------- packrow --------------------------------------------------*/
+/* Like PackRow, but writes the packed bytes to a file.
+ */
+LONG packrow (BYTE **pSource, FILE *dest, LONG rowSize)
+{
+	BYTE stackbuf[MaxPackedSize(1024)];
+	BYTE *packed, *pack_p;
+	LONG putSize;
+
+	if (MaxPackedSize(rowSize) <= (LONG)sizeof(stackbuf))
+	{
+		packed = stackbuf;
+	}
+	else
+	{
+		packed = malloc (MaxPackedSize(rowSize));
+		if (packed == NULL)
+		{
+			fprintf (stderr, "Out of memory\n");
+			exit (20);
+		}
+	}
+	pack_p = packed;
+	putSize = PackRow (pSource, &pack_p, rowSize);
+	fwrite (packed, 1, putSize, dest);
+	if (packed != stackbuf)
+	{
+		free (packed);
+	}
 	return putSize;
 }
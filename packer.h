@@ -17,6 +17,9 @@
 /* This macro computes the worst case packed size of a "row" of bytes. */
 #define MaxPackedSize(rowSize)	( (rowSize) + ( ((rowSize)+127) >> 7 ) )
 
+extern LONG PackRect (const BYTE *source, LONG pitch, LONG width, LONG height,
+					  BYTE from, BYTE to, BYTE *dest);
+extern LONG PackRow (BYTE **pSource, BYTE **pDest, LONG rowSize);
 extern LONG packrow (BYTE **pSource, FILE *dest, LONG rowSize);
 
 #endif
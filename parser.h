@@ -1,55 +1,126 @@
-#ifndef BISON_PARSER_H
-# define BISON_PARSER_H
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
-#ifndef YYSTYPE
-typedef union
+/* Bison interface for Yacc-like parsers in C
+
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
+
+   This program is free software: you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
+
+/* As a special exception, you may create a larger work that contains
+   part or all of the Bison parser skeleton and distribute that work
+   under terms of your choice, so long as that work isn't itself a
+   parser generator using the skeleton or a modified version thereof
+   as a parser skeleton.  Alternatively, if you modify or redistribute
+   the parser skeleton itself, you may (at your option) remove this
+   special exception, which will cause the skeleton and the resulting
+   Bison output files to be licensed under the GNU General Public
+   License without this special exception.
+
+   This special exception was added by the Free Software Foundation in
+   version 2.2 of Bison.  */
+
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
+#ifndef YY_YY_PARSER_H_INCLUDED
+# define YY_YY_PARSER_H_INCLUDED
+/* Debug traces.  */
+#ifndef YYDEBUG
+# define YYDEBUG 0
+#endif
+#if YYDEBUG
+extern int yydebug;
+#endif
+
+/* Token kinds.  */
+#ifndef YYTOKENTYPE
+# define YYTOKENTYPE
+  enum yytokentype
+  {
+    YYEMPTY = -2,
+    YYEOF = 0,                     /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    INT = 258,                     /* INT  */
+    FLOAT = 259,                   /* FLOAT  */
+    STRING = 260,                  /* STRING  */
+    ELLIPSIS = 261,                /* ELLIPSIS  */
+    RIGHT_ASSIGN = 262,            /* RIGHT_ASSIGN  */
+    LEFT_ASSIGN = 263,             /* LEFT_ASSIGN  */
+    ADD_ASSIGN = 264,              /* ADD_ASSIGN  */
+    SUB_ASSIGN = 265,              /* SUB_ASSIGN  */
+    MUL_ASSIGN = 266,              /* MUL_ASSIGN  */
+    DIV_ASSIGN = 267,              /* DIV_ASSIGN  */
+    MOD_ASSIGN = 268,              /* MOD_ASSIGN  */
+    AND_ASSIGN = 269,              /* AND_ASSIGN  */
+    XOR_ASSIGN = 270,              /* XOR_ASSIGN  */
+    OR_ASSIGN = 271,               /* OR_ASSIGN  */
+    RIGHT_OP = 272,                /* RIGHT_OP  */
+    LEFT_OP = 273,                 /* LEFT_OP  */
+    INC_OP = 274,                  /* INC_OP  */
+    DEC_OP = 275,                  /* DEC_OP  */
+    PTR_OP = 276,                  /* PTR_OP  */
+    AND_OP = 277,                  /* AND_OP  */
+    OR_OP = 278,                   /* OR_OP  */
+    LE_OP = 279,                   /* LE_OP  */
+    GE_OP = 280,                   /* GE_OP  */
+    EQ_OP = 281,                   /* EQ_OP  */
+    NE_OP = 282,                   /* NE_OP  */
+    ID = 283,                      /* ID  */
+    LOAD = 284,                    /* LOAD  */
+    CONFONT = 285,                 /* CONFONT  */
+    XHAIR = 286,                   /* XHAIR  */
+    IMAGE = 287,                   /* IMAGE  */
+    FONT = 288,                    /* FONT  */
+    SHADING = 289,                 /* SHADING  */
+    NORMAL = 290,                  /* NORMAL  */
+    CONSOLE = 291,                 /* CONSOLE  */
+    TRANSPARENT = 292,             /* TRANSPARENT  */
+    ORIGIN = 293,                  /* ORIGIN  */
+    FOREACH = 294,                 /* FOREACH  */
+    AS = 295,                      /* AS  */
+    VARIABLE = 296                 /* VARIABLE  */
+  };
+  typedef enum yytokentype yytoken_kind_t;
+#endif
+
+/* Value type.  */
+#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
+union YYSTYPE
 {
+#line 48 "parser.y"
+
 	int i;
 	double f;
 	char *s;
 	ShadeType shade;
-} yystype;
-# define YYSTYPE yystype
+	struct Step *step;
+
+#line 113 "parser.h"
+
+};
+typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
+# define YYSTYPE_IS_DECLARED 1
 #endif
-# define	INT	257
-# define	FLOAT	258
-# define	STRING	259
-# define	ELLIPSIS	260
-# define	RIGHT_ASSIGN	261
-# define	LEFT_ASSIGN	262
-# define	ADD_ASSIGN	263
-# define	SUB_ASSIGN	264
-# define	MUL_ASSIGN	265
-# define	DIV_ASSIGN	266
-# define	MOD_ASSIGN	267
-# define	AND_ASSIGN	268
-# define	XOR_ASSIGN	269
-# define	OR_ASSIGN	270
-# define	RIGHT_OP	271
-# define	LEFT_OP	272
-# define	INC_OP	273
-# define	DEC_OP	274
-# define	PTR_OP	275
-# define	AND_OP	276
-# define	OR_OP	277
-# define	LE_OP	278
-# define	GE_OP	279
-# define	EQ_OP	280
-# define	NE_OP	281
-# define	ID	282
-# define	LOAD	283
-# define	CONFONT	284
-# define	XHAIR	285
-# define	IMAGE	286
-# define	FONT	287
-# define	SHADING	288
-# define	NORMAL	289
-# define	CONSOLE	290
-# define	TRANSPARENT	291
-# define	ORIGIN	292
-
-
-extern YYSTYPE yylval;
-
-#endif /* not BISON_PARSER_H */
+
+
+
+
+int yyparse (ParseContext *context);
+
+
+#endif /* !YY_YY_PARSER_H_INCLUDED  */
@@ -34,17 +34,23 @@
 
 #include <malloc.h>
 #include "afx.h"
-
-void yyerror (char *);
-int yylex (void);
+#include "script.h"
 %}
 
+/* The parser is pure, and where it is in the script is passed to yyparse
+ * and on to the scanner with every token.
+ */
+%define api.pure full
+%parse-param { ParseContext *context }
+%lex-param { ParseContext *context }
+
 %union
 {
 	int i;
 	double f;
 	char *s;
 	ShadeType shade;
+	struct Step *step;
 }
 
 %token <i> INT
@@ -85,12 +91,27 @@ int yylex (void);
 %token CONSOLE
 %token TRANSPARENT
 %token ORIGIN
+%token FOREACH
+%token AS
+%token <s> VARIABLE
 
 %type <shade> shadetype
+%type <s> name
+
+%code
+{
+int ScriptLex (YYSTYPE *yylval, void *scanner);
+void yyerror (ParseContext *context, const char *s);
+
+static int yylex (YYSTYPE *yylval, ParseContext *context)
+{
+	return ScriptLex (yylval, context->Scanner);
+}
+}
 
 %%
 
-start: | commands { if (ImageData != NULL) free (ImageData); };
+start: | commands;
 
 /* An image must be loaded before any file-creators are used */
 
@@ -103,80 +124,49 @@ command2: nonimage | image;
 /* A nonimage is a command that does not require an image to be loaded */
 
 nonimage:
-	LOAD STRING ';'
-	{
-		if (ImageData != NULL)
-			free (ImageData);
-		LoadPic ($2, &ImageData, &ImageWidth, &ImageHeight, &ImageSrcWidth,
-			&ImageCX, &ImageCY, ImagePalette);
-		free ($2);
-	}
+	LOAD name ';'				{ AddStep (context->Owner, STEP_Load, $2, context->Owner->Retrans, 0, 0); }
 
 	| TRANSPARENT INT ';'
 	{
 		if ($2 >= 0 && $2 <= 255)
-			RetransImage = $2;
+			context->Owner->Retrans = $2;
 		else
-			yyerror ("Transparent color out of range\n");
+			yyerror (context, "Transparent color out of range");
 	}
 ;
 
 /* An image is a command that does require an image to be loaded */
 
 image:
-	ORIGIN '(' INT ',' INT ')' ';'
-	{
-		ImageCX = $3;
-		ImageCY = $5;
-	}
-
-	| CONFONT STRING ';'
-	{
-		if (ImageData)
-			WriteConFont ($2, ImageData, ImageWidth, ImageHeight, ImageSrcWidth);
-		free ($2);
-	}
-
-	| XHAIR STRING ';'
-	{
-		if (ImageData)
-		{
-			if (ImageCX == 0x8000)
-			{
-				ImageCX = ImageSrcWidth / 2;
-				ImageCY = ImageHeight / 2;
-			}
-			WriteImage ($2, ImageData, ImageWidth, ImageHeight, ImageSrcWidth,
-						ImageCX, ImageCY, ImagePalette);
-		}
-		free ($2);
-	}
+	ORIGIN '(' INT ',' INT ')' ';'	{ AddStep (context->Owner, STEP_Origin, NULL, $3, $5, 0); }
+	| CONFONT name ';'				{ AddStep (context->Owner, STEP_ConFont, $2, 0, 0, 0); }
+	| XHAIR name ';'				{ AddStep (context->Owner, STEP_Crosshair, $2, 0, 0, 0); }
+	| IMAGE name ';'				{ AddStep (context->Owner, STEP_Image, $2, 0, 0, 0); }
+
+	| FONT name { AddStep (context->Owner, STEP_StartFont, $2, 0, 0, 0); }
+	  fontchunks ';' { AddStep (context->Owner, STEP_EndFont, NULL, 0, 0, 0); }
+
+	/* A loop counts as an image command, since its body usually has some.
+	 * The body is run once for every file that matches the pattern, with
+	 * the variable standing in for the file's name.
+	 */
+	| FOREACH name AS VARIABLE '{' { $<step>$ = StartLoop (context->Owner, $2, $4); }
+	  block '}' { EndLoop (context->Owner, $<step>6); }
+;
 
-	| IMAGE STRING ';'
-	{
-		if (ImageData)
-		{
-			if (ImageCX == 0x8000)
-			{
-				ImageCX = 0;
-				ImageCY = 0;
-			}
-			WriteImage ($2, ImageData, ImageWidth, ImageHeight, ImageSrcWidth,
-						ImageCX, ImageCY, ImagePalette);
-		}
-		free ($2);
-	}
+block: | block nonimage | block image;
 
-	| FONT STRING { StartFont ($2, ImageData, ImageWidth, ImageHeight, ImageSrcWidth, ImagePalette); }
-	  fontchunks ';' { EndFont (); free ($2); }
-;
+/* A file name can be a string, which may have variables in it, or just
+ * a variable.
+ */
+name: STRING | VARIABLE;
 
 fontchunks: | fontchunks fontchunk;
 
 fontchunk:
-	INT INT INT { GrabFont ($1, $2, $3); }		/* x y startchar */
+	INT INT INT { AddStep (context->Owner, STEP_GrabFont, NULL, $1, $2, $3); }		/* x y startchar */
 
-	| SHADING '=' shadetype { SetFontShading ($3); }
+	| SHADING '=' shadetype { AddStep (context->Owner, STEP_Shading, NULL, $3, 0, 0); }
 ;
 
 shadetype:
@@ -186,9 +176,42 @@ shadetype:
 
 %%
 
-extern int column, lineno;
+int yylex_init_extra (ParseContext *context, void **scanner);
+void yyset_in (FILE *file, void *scanner);
+int yylex_destroy (void *scanner);
 
-void yyerror (char *s)
+void yyerror (ParseContext *context, const char *s)
 {
-	fprintf (stderr, "line %d, col %d: %s\n", lineno, column+1, s);
+	Eprintf ("%s: line %d, col %d: %s\n", context->FileName,
+		context->Line, context->Column+1, s);
+}
+
+// Parses a script file into its list of steps. The parser and scanner
+// keep all their state in context, so several scripts can be parsed at
+// once.
+int ParseScript (Script *script)
+{
+	FILE *file = fopen (script->Name, "r");
+	ParseContext context;
+	int failed;
+
+	if (file == NULL)
+	{
+		Eprintf ("Could not open %s\n", script->Name);
+		return 20;
+	}
+	context.Owner = script;
+	context.FileName = script->Name;
+	context.Line = 1;
+	context.Column = 0;
+	if (yylex_init_extra (&context, &context.Scanner) != 0)
+	{
+		fprintf (stderr, "Out of memory\n");
+		exit (20);
+	}
+	yyset_in (file, context.Scanner);
+	failed = yyparse (&context);
+	yylex_destroy (context.Scanner);
+	fclose (file);
+	return failed;
 }
@@ -0,0 +1,1348 @@
+/*
+** script.c
+** Runs the steps a script was compiled to, in parallel where it can.
+**
+**---------------------------------------------------------------------------
+** Copyright 2001 Randy Heit
+** All rights reserved.
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions
+** are met:
+**
+** 1. Redistributions of source code must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. The name of the author may not be used to endorse or promote products
+**    derived from this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+** IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+** OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+** IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+** NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+** DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+** THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+** THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**---------------------------------------------------------------------------
+*/
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#include <ctype.h>
+
+#include "afx.h"
+#include "script.h"
+#include "threads.h"
+#include "deflate.h"
+#include "files.h"
+
+// Change this whenever a change to imagetool would change what a script
+// builds, so that the build database doesn't skip anything.
+#define BUILD_DB_VERSION	2
+
+typedef struct
+{
+	Step *First;
+	int NumSteps;
+	int Level;			// runs once every chain at a lower level is done
+	Script *Owner;
+	bool Failed;
+	bool UpToDate;		// skipped, because nothing it uses has changed
+	ULONG CRC, Adler;	// hash of the steps and the file they load
+	OutputLog *Log;
+	struct BuildRecord *Built;	// every file its outputs left behind
+	int NumBuilt;
+} Chain;
+
+// What the build database remembers about each file a script writes.
+// Most outputs are one file, but a font with more than 256 characters
+// is one file for each page, all of them under the font's name.
+typedef struct BuildRecord
+{
+	char *Output;		// the name the script gave
+	char *Name;			// the file that was written
+	ULONG CRC, Adler;	// hash of the chain that built it
+	long Size;			// -1 if building it didn't leave a file
+	long MTime;
+} BuildRecord;
+
+typedef struct
+{
+	Chain *Chains;
+	int *Order;			// the chains at the current level
+} LevelJobs;
+
+Step *AddStep (Script *script, StepType type, char *name, int arg0, int arg1, int arg2)
+{
+	Step *step = malloc (sizeof(Step));
+
+	if (step == NULL)
+	{
+		fprintf (stderr, "Out of memory\n");
+		exit (20);
+	}
+	step->Type = type;
+	step->Name = name;
+	step->Arg[0] = arg0;
+	step->Arg[1] = arg1;
+	step->Arg[2] = arg2;
+	step->Var = NULL;
+	step->Body = NULL;
+	step->Next = NULL;
+	*script->LastStep = step;
+	script->LastStep = &step->Next;
+	return step;
+}
+
+// Steps added after this go in the loop's body, until EndLoop.
+Step *StartLoop (Script *script, char *pattern, char *var)
+{
+	Step *loop = AddStep (script, STEP_Foreach, pattern, 0, 0, 0);
+
+	loop->Var = var;
+	script->LastStep = &loop->Body;
+	return loop;
+}
+
+void EndLoop (Script *script, Step *loop)
+{
+	script->LastStep = &loop->Next;
+}
+
+static void FreeSteps (Step *step)
+{
+	Step *next;
+
+	for (; step != NULL; step = next)
+	{
+		next = step->Next;
+		FreeSteps (step->Body);
+		if (step->Name != NULL)
+		{
+			free (step->Name);
+		}
+		if (step->Var != NULL)
+		{
+			free (step->Var);
+		}
+		free (step);
+	}
+}
+
+// The value of a loop variable, while expanding the loop.
+typedef struct Binding
+{
+	const char *Var;
+	const char *Value;
+	const struct Binding *Outer;
+} Binding;
+
+static void AppendText (char **text, int *len, int *size, const char *add, int addlen)
+{
+	if (*len + addlen >= *size)
+	{
+		*size = (*len + addlen) * 2 + 1;
+		*text = realloc (*text, *size);
+		if (*text == NULL)
+		{
+			fprintf (stderr, "Out of memory\n");
+			exit (20);
+		}
+	}
+	memcpy (*text + *len, add, addlen);
+	*len += addlen;
+	(*text)[*len] = 0;
+}
+
+// Returns a copy of name with every loop variable in it replaced by its
+// value. A variable can be followed by any of these, like in csh:
+//   :r  to drop the extension
+//   :e  for only the extension
+//   :h  for only the directory
+//   :t  to drop the directory
+static char *Substitute (const char *name, const Binding *bindings)
+{
+	char *text = NULL;
+	int len = 0, size = 0;
+
+	AppendText (&text, &len, &size, "", 0);
+	while (*name != 0)
+	{
+		const Binding *bound = NULL;
+		const char *value, *slash, *dot;
+		int varlen, valuelen;
+
+		if (*name == '$')
+		{
+			for (varlen = 1; isalnum ((UBYTE)name[varlen]) || name[varlen] == '_'; ++varlen)
+				;
+			for (bound = bindings; bound != NULL; bound = bound->Outer)
+			{
+				if (strlen (bound->Var) == (size_t)varlen && strncmp (bound->Var, name, varlen) == 0)
+					break;
+			}
+		}
+		if (bound == NULL)
+		{
+			AppendText (&text, &len, &size, name++, 1);
+			continue;
+		}
+
+		value = bound->Value;
+		valuelen = strlen (value);
+		name += varlen;
+		while (name[0] == ':' && name[1] != 0 && strchr ("rehtRHET", name[1]) &&
+			!isalnum ((UBYTE)name[2]) && name[2] != '_')
+		{
+			const char *end = value + valuelen;
+
+			for (slash = end; slash > value && slash[-1] != '/' && slash[-1] != '\\'; --slash)
+				;
+			for (dot = end; dot > slash && dot[-1] != '.'; --dot)
+				;
+			dot = dot > slash ? dot - 1 : NULL;
+
+			switch (tolower (name[1]))
+			{
+			case 'r':
+				if (dot != NULL)
+					valuelen = dot - value;
+				break;
+			case 'e':
+				value = dot != NULL ? dot + 1 : end;
+				valuelen = end - value;
+				break;
+			case 'h':
+				valuelen = slash > value ? slash - value - 1 : 1;
+				value = slash > value ? value : ".";
+				break;
+			case 't':
+				valuelen = end - slash;
+				value = slash;
+				break;
+			}
+			name += 2;
+		}
+		AppendText (&text, &len, &size, value, valuelen);
+	}
+	return text;
+}
+
+// Adds a copy of the steps to the script, with the variables filled in
+// and every loop run once for each file it matches.
+static void ExpandSteps (Script *script, const Step *step, const Binding *bindings)
+{
+	for (; step != NULL; step = step->Next)
+	{
+		if (step->Type == STEP_Foreach)
+		{
+			char *pattern = Substitute (step->Name, bindings);
+			char **files;
+			int count, i;
+
+			files = MatchFiles (pattern, &count);
+			if (script->Watch != NULL)
+			{
+				WatchPattern (script->Watch, pattern);
+			}
+			if (count == 0)
+			{
+				Eprintf ("%s: nothing matches %s\n", script->Name, pattern);
+			}
+			for (i = 0; i < count; ++i)
+			{
+				Binding binding;
+
+				binding.Var = step->Var;
+				binding.Value = files[i];
+				binding.Outer = bindings;
+				ExpandSteps (script, step->Body, &binding);
+			}
+			FreeFileList (files);
+			free (pattern);
+		}
+		else
+		{
+			AddStep (script, step->Type,
+				step->Name != NULL ? Substitute (step->Name, bindings) : NULL,
+				step->Arg[0], step->Arg[1], step->Arg[2]);
+		}
+	}
+}
+
+// Turns the script's loops into plain steps. The files a loop matches
+// aren't looked for until the script is about to run.
+static void ExpandLoops (Script *script)
+{
+	Step *steps = script->FirstStep;
+	Step *step;
+
+	for (step = steps; step != NULL; step = step->Next)
+	{
+		if (step->Type == STEP_Foreach)
+			break;
+	}
+	if (step == NULL)
+	{
+		return;
+	}
+	script->FirstStep = NULL;
+	script->LastStep = &script->FirstStep;
+	ExpandSteps (script, steps, NULL);
+	FreeSteps (steps);
+}
+
+static bool IsOutput (const Step *step)
+{
+	return step->Type == STEP_ConFont || step->Type == STEP_Crosshair ||
+		step->Type == STEP_Image || step->Type == STEP_StartFont;
+}
+
+// Who last used a file, while chains are being put into levels.
+typedef struct
+{
+	const char *Name;
+	int WriteLevel;		// level of the last chain to write it
+	int ReadLevel;		// highest level to read it since then
+} FileUse;
+
+static unsigned int HashName (const char *name)
+{
+	unsigned int hash = 0;
+
+	while (*name)
+	{
+		hash = hash * 31 + tolower ((UBYTE)*name++);
+	}
+	return hash;
+}
+
+static FileUse *FindFileUse (FileUse *table, unsigned int mask, const char *name)
+{
+	unsigned int i = HashName (name) & mask;
+
+	while (table[i].Name != NULL && stricmp (table[i].Name, name) != 0)
+	{
+		i = (i + 1) & mask;
+	}
+	if (table[i].Name == NULL)
+	{
+		table[i].Name = name;
+		table[i].WriteLevel = -1;
+		table[i].ReadLevel = -1;
+	}
+	return &table[i];
+}
+
+// Puts each chain in the lowest level it can run in. A chain has to wait
+// for earlier chains if it reads a file one of them writes, writes a file
+// one of them reads, or writes the same file. Returns the highest level.
+static int LevelChains (Chain *chains, int numchains)
+{
+	FileUse *table, *use;
+	unsigned int mask;
+	Step *step;
+	int numnames, maxlevel;
+	int i, j;
+
+	for (i = numnames = 0; i < numchains; ++i)
+	{
+		numnames += chains[i].NumSteps;
+	}
+	for (mask = 63; mask < (unsigned int)numnames * 2; mask = mask * 2 + 1)
+		;
+	table = calloc (mask + 1, sizeof(FileUse));
+	if (table == NULL)
+	{
+		fprintf (stderr, "Out of memory\n");
+		exit (20);
+	}
+
+	maxlevel = -1;
+	for (i = 0; i < numchains; ++i)
+	{
+		Chain *chain = &chains[i];
+		int level = 0;
+
+		for (j = 0, step = chain->First; j < chain->NumSteps; ++j, step = step->Next)
+		{
+			if (step->Type == STEP_Load)
+			{
+				use = FindFileUse (table, mask, step->Name);
+				if (use->WriteLevel >= level)
+					level = use->WriteLevel + 1;
+			}
+			else if (IsOutput (step))
+			{
+				use = FindFileUse (table, mask, step->Name);
+				if (use->WriteLevel >= level)
+					level = use->WriteLevel + 1;
+				if (use->ReadLevel >= level)
+					level = use->ReadLevel + 1;
+			}
+		}
+		for (j = 0, step = chain->First; j < chain->NumSteps; ++j, step = step->Next)
+		{
+			if (step->Type == STEP_Load)
+			{
+				use = FindFileUse (table, mask, step->Name);
+				if (use->ReadLevel < level)
+					use->ReadLevel = level;
+			}
+			else if (IsOutput (step))
+			{
+				use = FindFileUse (table, mask, step->Name);
+				use->WriteLevel = level;
+				use->ReadLevel = -1;
+			}
+		}
+		if (level > maxlevel)
+		{
+			maxlevel = level;
+		}
+		chain->Level = level;
+	}
+	free (table);
+	return maxlevel;
+}
+
+static void HashChainBytes (Chain *chain, const void *data, int len)
+{
+	chain->CRC = CRC32 (chain->CRC, (const UBYTE *)data, len);
+	chain->Adler = Adler32 (chain->Adler, (const UBYTE *)data, len);
+}
+
+// Hashes everything that goes into a chain's outputs: its steps, the
+// contents of the file it loads, and the options that change how fonts
+// are built.
+static void HashChain (Chain *chain)
+{
+	int header[2] = { BUILD_DB_VERSION, chain->Owner->Opts->TrimSpacing };
+	UBYTE buffer[65536];
+	Step *step;
+	FILE *file;
+	int i, len;
+
+	chain->CRC = 0;
+	chain->Adler = 1;
+	HashChainBytes (chain, header, sizeof(header));
+
+	for (i = 0, step = chain->First; i < chain->NumSteps; ++i, step = step->Next)
+	{
+		HashChainBytes (chain, &step->Type, sizeof(step->Type));
+		HashChainBytes (chain, step->Arg, sizeof(step->Arg));
+		if (step->Name != NULL)
+		{
+			HashChainBytes (chain, step->Name, strlen (step->Name) + 1);
+		}
+		if (step->Type == STEP_Load && (file = fopen (step->Name, "rb")) != NULL)
+		{
+			while ((len = fread (buffer, 1, sizeof(buffer), file)) > 0)
+			{
+				HashChainBytes (chain, buffer, len);
+			}
+			fclose (file);
+		}
+	}
+}
+
+static int CompareRecords (const void *arg1, const void *arg2)
+{
+	const BuildRecord *a = (const BuildRecord *)arg1;
+	const BuildRecord *b = (const BuildRecord *)arg2;
+	int cmp = stricmp (a->Output, b->Output);
+
+	return cmp != 0 ? cmp : stricmp (a->Name, b->Name);
+}
+
+static int CompareRecordOutputs (const void *arg1, const void *arg2)
+{
+	return stricmp (((const BuildRecord *)arg1)->Output, ((const BuildRecord *)arg2)->Output);
+}
+
+// Returns the first of the records for an output, and how many there are.
+static BuildRecord *FindRecords (const Script *script, const char *output, int *count)
+{
+	BuildRecord key, *first, *last, *end;
+
+	*count = 0;
+	if (script->NumRecords == 0)
+		return NULL;
+	key.Output = (char *)output;
+	first = bsearch (&key, script->Records, script->NumRecords, sizeof(BuildRecord), CompareRecordOutputs);
+	if (first == NULL)
+		return NULL;
+	end = script->Records + script->NumRecords;
+	for (last = first + 1; last < end && CompareRecordOutputs (last, &key) == 0; ++last)
+		;
+	while (first > script->Records && CompareRecordOutputs (first - 1, &key) == 0)
+		first--;
+	*count = (int)(last - first);
+	return first;
+}
+
+// Fills in a record with an output file as it is now.
+static void StatRecord (BuildRecord *record)
+{
+	struct stat st;
+
+	if (stat (record->Name, &st) == 0)
+	{
+		record->Size = (long)st.st_size;
+		record->MTime = (long)st.st_mtime;
+	}
+	else
+	{
+		record->Size = -1;
+		record->MTime = 0;
+	}
+}
+
+// Notes a file that one of a chain's outputs wrote. The rest of the
+// record is filled in when the build database is saved.
+static void AddBuilt (Chain *chain, char *output, const char *name)
+{
+	BuildRecord *record;
+
+	chain->Built = realloc (chain->Built, (chain->NumBuilt + 1) * sizeof(BuildRecord));
+	if (chain->Built == NULL)
+	{
+		fprintf (stderr, "Out of memory\n");
+		exit (20);
+	}
+	record = &chain->Built[chain->NumBuilt];
+	record->Output = output;
+	record->Name = strdup (name);
+	if (record->Name == NULL)
+	{
+		fprintf (stderr, "Out of memory\n");
+		exit (20);
+	}
+	chain->NumBuilt++;
+}
+
+// A chain is up to date if it was last built from the same hash, and
+// every file its outputs wrote is still there, untouched since. If it
+// is, its records are kept for the next build database.
+static bool ChainIsCurrent (Chain *chain)
+{
+	BuildRecord *records, now;
+	Step *step;
+	int i, j, count, outputs = 0;
+
+	for (i = 0, step = chain->First; i < chain->NumSteps; ++i, step = step->Next)
+	{
+		if (!IsOutput (step))
+			continue;
+
+		records = FindRecords (chain->Owner, step->Name, &count);
+		if (count == 0)
+			return false;
+		for (j = 0; j < count; ++j)
+		{
+			if (records[j].CRC != chain->CRC || records[j].Adler != chain->Adler)
+				return false;
+			now.Name = records[j].Name;
+			StatRecord (&now);
+			if (now.Size < 0 || now.Size != records[j].Size || now.MTime != records[j].MTime)
+				return false;
+		}
+		outputs++;
+	}
+	if (outputs == 0)
+		return false;
+
+	for (i = 0, step = chain->First; i < chain->NumSteps; ++i, step = step->Next)
+	{
+		if (!IsOutput (step))
+			continue;
+
+		records = FindRecords (chain->Owner, step->Name, &count);
+		for (j = 0; j < count; ++j)
+		{
+			AddBuilt (chain, step->Name, records[j].Name);
+		}
+	}
+	return true;
+}
+
+static void FreeBuilt (Chain *chain)
+{
+	int i;
+
+	for (i = 0; i < chain->NumBuilt; ++i)
+	{
+		free (chain->Built[i].Name);
+	}
+	free (chain->Built);
+	chain->Built = NULL;
+	chain->NumBuilt = 0;
+}
+
+static char *BuildDBName (const char *scriptname)
+{
+	char *name = malloc (strlen (scriptname) + 4);
+
+	if (name != NULL)
+	{
+		strcpy (name, scriptname);
+		strcat (name, ".db");
+	}
+	return name;
+}
+
+// Reads the build database left by the last run of this script. The
+// first line identifies the file, and each line after that is a record:
+// the CRC and Adler of the chain, then the file's size and time, the
+// output's name, a tab, and the file's name.
+static void LoadBuildDB (Script *script)
+{
+	char *dbname = BuildDBName (script->Name);
+	char line[2100];
+	FILE *file;
+	int maxrecords = 0;
+
+	script->NumRecords = 0;
+	script->Records = NULL;
+	file = dbname != NULL ? fopen (dbname, "r") : NULL;
+	free (dbname);
+	if (file == NULL)
+		return;
+
+	if (fgets (line, sizeof(line), file) != NULL &&
+		strcmp (line, "imagetool build db\n") == 0)
+	{
+		while (fgets (line, sizeof(line), file) != NULL)
+		{
+			BuildRecord record;
+			char *tab;
+			int len, namepos;
+
+			len = strlen (line);
+			if (len == 0 || line[len-1] != '\n')
+				break;
+			line[len-1] = 0;
+			if (sscanf (line, "%x %x %ld %ld %n", &record.CRC, &record.Adler,
+				&record.Size, &record.MTime, &namepos) < 4)
+				break;
+			tab = strchr (line + namepos, '\t');
+			if (tab == NULL)
+				break;
+			*tab = 0;
+			if (script->NumRecords == maxrecords)
+			{
+				BuildRecord *grown;
+
+				maxrecords = maxrecords ? maxrecords * 2 : 64;
+				grown = realloc (script->Records, maxrecords * sizeof(BuildRecord));
+				if (grown == NULL)
+					break;
+				script->Records = grown;
+			}
+			record.Output = strdup (line + namepos);
+			record.Name = strdup (tab + 1);
+			if (record.Output == NULL || record.Name == NULL)
+			{
+				free (record.Output);
+				free (record.Name);
+				break;
+			}
+			script->Records[script->NumRecords++] = record;
+		}
+	}
+	fclose (file);
+	qsort (script->Records, script->NumRecords, sizeof(BuildRecord), CompareRecords);
+}
+
+// Writes a new build database with a record for every file written by
+// every chain from the script that either built without trouble or was
+// already up to date.
+static void SaveBuildDB (Script *script, Chain *chains, int numchains)
+{
+	char *dbname = BuildDBName (script->Name);
+	FILE *file;
+	int i, j;
+
+	file = dbname != NULL ? fopen (dbname, "w") : NULL;
+	if (file == NULL)
+	{
+		Eprintf ("Could not write %s\n", dbname != NULL ? dbname : script->Name);
+		free (dbname);
+		return;
+	}
+	fprintf (file, "imagetool build db\n");
+	for (i = 0; i < numchains; ++i)
+	{
+		if (chains[i].Owner != script || chains[i].Failed)
+			continue;
+
+		for (j = 0; j < chains[i].NumBuilt; ++j)
+		{
+			BuildRecord *record = &chains[i].Built[j];
+
+			StatRecord (record);
+			fprintf (file, "%08x %08x %ld %ld %s\t%s\n", chains[i].CRC, chains[i].Adler,
+				record->Size, record->MTime, record->Output, record->Name);
+		}
+	}
+	if (fclose (file) != 0)
+	{
+		Eprintf ("Could not write %s\n", dbname);
+	}
+	free (dbname);
+}
+
+static void FreeBuildDB (Script *script)
+{
+	int i;
+
+	for (i = 0; i < script->NumRecords; ++i)
+	{
+		free (script->Records[i].Output);
+		free (script->Records[i].Name);
+	}
+	free (script->Records);
+	script->Records = NULL;
+	script->NumRecords = 0;
+}
+
+// Runs one chain of steps, which is everything from one load up to the
+// next, with its own copy of the image.
+static void RunChain (void *userdata, int job)
+{
+	LevelJobs *jobs = (LevelJobs *)userdata;
+	Chain *chain = &jobs->Chains[jobs->Order[job]];
+	UBYTE palette[768];
+	UBYTE *data = NULL;
+	int width = 0, height = 0, srcwidth = 0;
+	int cx = 0, cy = 0;
+	Step *step, *fontstep = NULL;
+	FontBuilder *font = NULL;
+	char **files;
+	int i, j, numfiles;
+
+	memset (palette, 0, sizeof(palette));
+	chain->Log = StartLog ();
+
+	HashChain (chain);
+	if (!chain->Owner->Opts->RebuildAll && ChainIsCurrent (chain))
+	{
+		chain->UpToDate = true;
+		EndLog ();
+		return;
+	}
+
+	for (i = 0, step = chain->First; i < chain->NumSteps; ++i, step = step->Next)
+	{
+		switch (step->Type)
+		{
+		case STEP_Load:
+			LoadPic (step->Name, &data, &width, &height, &srcwidth,
+				&cx, &cy, palette, (UBYTE)step->Arg[0]);
+			chain->Failed |= data == NULL;
+			break;
+
+		case STEP_Origin:
+			cx = step->Arg[0];
+			cy = step->Arg[1];
+			break;
+
+		case STEP_ConFont:
+			ForgetPic (step->Name);
+			if (data)
+				chain->Failed |= WriteConFont (step->Name, data, width, height, srcwidth) != 0;
+			else
+				chain->Failed = true;
+			AddBuilt (chain, step->Name, step->Name);
+			break;
+
+		case STEP_Crosshair:
+		case STEP_Image:
+			ForgetPic (step->Name);
+			if (data)
+			{
+				if (cx == 0x8000)
+				{
+					cx = step->Type == STEP_Crosshair ? srcwidth / 2 : 0;
+					cy = step->Type == STEP_Crosshair ? height / 2 : 0;
+				}
+				chain->Failed |= WriteImage (step->Name, data, width, height,
+							srcwidth, cx, cy, palette) != 0;
+			}
+			else
+			{
+				chain->Failed = true;
+			}
+			AddBuilt (chain, step->Name, step->Name);
+			break;
+
+		case STEP_StartFont:
+			// StartFont remaps the image in place
+			UnsharePic (&data, width, height);
+			FreeFont (font);
+			font = StartFont (step->Name, data, width, height, srcwidth, palette,
+				chain->Owner->Opts);
+			fontstep = step;
+			break;
+
+		case STEP_GrabFont:
+			if (font != NULL)
+				GrabFont (font, step->Arg[0], step->Arg[1], step->Arg[2]);
+			break;
+
+		case STEP_Shading:
+			if (font != NULL)
+				SetFontShading (font, (ShadeType)step->Arg[0]);
+			break;
+
+		case STEP_EndFont:
+			if (font == NULL)
+			{
+				chain->Failed = true;
+				break;
+			}
+			chain->Failed |= EndFont (font);
+			files = FontFiles (font, &numfiles);
+			for (j = 0; j < numfiles && fontstep != NULL; ++j)
+			{
+				AddBuilt (chain, fontstep->Name, files[j]);
+			}
+			FreeFont (font);
+			font = NULL;
+			break;
+
+		case STEP_Foreach:		// expanded before anything runs
+			break;
+		}
+	}
+
+	FreeFont (font);
+	ReleasePic (data);
+	EndLog ();
+}
+
+static int CompareNamePtrs (const void *arg1, const void *arg2)
+{
+	return stricmp (*(char *const *)arg1, *(char *const *)arg2);
+}
+
+// Returns every file the chains build, sorted.
+static char **ListOutputs (Chain *chains, int numchains, int *count)
+{
+	char **outputs;
+	Step *step;
+	int numoutputs, i, j;
+
+	for (i = numoutputs = 0; i < numchains; ++i)
+	{
+		for (j = 0, step = chains[i].First; j < chains[i].NumSteps; ++j, step = step->Next)
+		{
+			numoutputs += IsOutput (step);
+		}
+	}
+	outputs = malloc ((numoutputs + 1) * sizeof(char *));
+	if (outputs == NULL)
+	{
+		fprintf (stderr, "Out of memory\n");
+		exit (20);
+	}
+	for (i = numoutputs = 0; i < numchains; ++i)
+	{
+		for (j = 0, step = chains[i].First; j < chains[i].NumSteps; ++j, step = step->Next)
+		{
+			if (IsOutput (step))
+				outputs[numoutputs++] = step->Name;
+		}
+	}
+	qsort (outputs, numoutputs, sizeof(char *), CompareNamePtrs);
+	*count = numoutputs;
+	return outputs;
+}
+
+// Returns every file the chains load, except for ones that a chain
+// builds. There is room left at the front for the names of the scripts.
+static char **ListSources (Chain *chains, int numchains, int numscripts, int *count)
+{
+	char **outputs, **sources;
+	Step *step;
+	int numoutputs, numsources, i, j;
+
+	outputs = ListOutputs (chains, numchains, &numoutputs);
+	for (i = numsources = 0; i < numchains; ++i)
+	{
+		for (j = 0, step = chains[i].First; j < chains[i].NumSteps; ++j, step = step->Next)
+		{
+			numsources += step->Type == STEP_Load;
+		}
+	}
+	sources = malloc ((numscripts + numsources + 1) * sizeof(char *));
+	if (sources == NULL)
+	{
+		fprintf (stderr, "Out of memory\n");
+		exit (20);
+	}
+	for (i = 0, numsources = numscripts; i < numchains; ++i)
+	{
+		for (j = 0, step = chains[i].First; j < chains[i].NumSteps; ++j, step = step->Next)
+		{
+			if (step->Type == STEP_Load &&
+				bsearch (&step->Name, outputs, numoutputs, sizeof(char *), CompareNamePtrs) == NULL)
+			{
+				sources[numsources++] = step->Name;
+			}
+		}
+	}
+	free (outputs);
+	*count = numsources;
+	return sources;
+}
+
+// Tells the watch about the scripts and every file they read, except for
+// ones they build, since those change whenever the scripts run.
+static void WatchSources (FileWatch *watch, Chain *chains, int numchains,
+	int numscripts, char **names)
+{
+	char **sources;
+	int numsources, i;
+
+	sources = ListSources (chains, numchains, numscripts, &numsources);
+	memcpy (sources, names, numscripts * sizeof(char *));
+	for (i = 0; i < numsources; ++i)
+	{
+		WatchFile (watch, sources[i]);
+	}
+	free (sources);
+}
+
+// Writes a dependency file for make or ninja, saying which files the
+// scripts build from which. The outputs are the files that were actually
+// written, so a font with pages lists the pages. If a script couldn't be
+// parsed or any chain failed, an old dependency file is removed instead,
+// since the build it describes is no longer what is on disk.
+static int WriteScriptDeps (const Options *options, Chain *chains, int numchains,
+	int numscripts, char **names, bool parsefailed)
+{
+	char **sources, **outputs;
+	char *depname = options->DepFile;
+	int numsources, numoutputs, failed;
+	int i, j;
+
+	if (depname == NULL)
+	{
+		depname = malloc (strlen (names[0]) + 3);
+		if (depname == NULL)
+		{
+			fprintf (stderr, "Out of memory\n");
+			exit (20);
+		}
+		strcpy (depname, names[0]);
+		strcat (depname, ".d");
+	}
+	for (i = numoutputs = 0; i < numchains && !chains[i].Failed; ++i)
+	{
+		numoutputs += chains[i].NumBuilt;
+	}
+	if (parsefailed || i < numchains)
+	{
+		remove (depname);
+		failed = 0;
+	}
+	else
+	{
+		outputs = malloc ((numoutputs + 1) * sizeof(char *));
+		if (outputs == NULL)
+		{
+			fprintf (stderr, "Out of memory\n");
+			exit (20);
+		}
+		for (i = numoutputs = 0; i < numchains; ++i)
+		{
+			for (j = 0; j < chains[i].NumBuilt; ++j)
+			{
+				outputs[numoutputs++] = chains[i].Built[j].Name;
+			}
+		}
+		sources = ListSources (chains, numchains, numscripts, &numsources);
+		memcpy (sources, names, numscripts * sizeof(char *));
+		failed = WriteDepFile (depname, options->DepTarget, outputs, numoutputs, sources, numsources);
+		free (outputs);
+		free (sources);
+	}
+	if (depname != options->DepFile)
+	{
+		free (depname);
+	}
+	return failed;
+}
+
+// Rough costs for --plan, measured with one thread on an ordinary PC.
+// They are only meant to tell big jobs from small ones.
+typedef struct
+{
+	const char *Format;
+	int NS;				// to decode one pixel
+} DecodeCost;
+
+typedef struct
+{
+	StepType Type;
+	int NS;				// per pixel of the image it is made from
+	int Percent;		// how big the output is next to that image
+} OutputCost;
+
+static const DecodeCost DecodeCosts[] =
+{
+	{ "bmp",	5 },
+	{ "pcx",	17 },
+	{ "ilbm",	22 },
+	{ "imgz",	6 },
+	{ "fon1",	8 },
+	{ "fon2",	8 },
+	{ "patch",	9 }
+};
+
+static const OutputCost OutputCosts[] =
+{
+	{ STEP_ConFont,		8,	52 },
+	{ STEP_Crosshair,	6,	50 },
+	{ STEP_Image,		6,	50 },
+	{ STEP_StartFont,	75,	65 }
+};
+
+static const char *FormatTime (char *buf, double ns)
+{
+	if (ns < 1e6)
+		sprintf (buf, "%.2f ms", ns / 1e6);
+	else if (ns < 1e9)
+		sprintf (buf, "%.1f ms", ns / 1e6);
+	else
+		sprintf (buf, "%.1f s", ns / 1e9);
+	return buf;
+}
+
+static const char *FormatSize (char *buf, double bytes)
+{
+	if (bytes < 1024)
+		sprintf (buf, "%.0f bytes", bytes);
+	else if (bytes < 1024*1024)
+		sprintf (buf, "%.1f KB", bytes / 1024);
+	else
+		sprintf (buf, "%.1f MB", bytes / (1024*1024));
+	return buf;
+}
+
+// Prints what one chain would do, and returns roughly how long that would
+// take in nanoseconds. Only image headers are read.
+static double PlanChain (Chain *chain, char **outputs, int numoutputs,
+	int maxlevel, double *written)
+{
+	char timebuf[32], sizebuf[32];
+	const char *format = NULL;
+	double pixels = 0, ns = 0;
+	Step *step;
+	int width, height, i, j;
+
+	HashChain (chain);
+	chain->UpToDate = !chain->Owner->Opts->RebuildAll && ChainIsCurrent (chain);
+
+	for (i = 0, step = chain->First; i < chain->NumSteps; ++i, step = step->Next)
+	{
+		if (step->Type == STEP_Load)
+		{
+			Printf ("  load %s: ", step->Name);
+			if (ProbePic (step->Name, &format, &width, &height))
+			{
+				pixels = (double)width * height;
+				for (j = 0; j < (int)(sizeof(DecodeCosts)/sizeof(DecodeCosts[0])); ++j)
+				{
+					if (strcmp (DecodeCosts[j].Format, format) == 0)
+						ns = pixels * DecodeCosts[j].NS;
+				}
+				Printf ("%s, %d x %d, ~%s", format, width, height, FormatTime (timebuf, ns));
+			}
+			else if (bsearch (&step->Name, outputs, numoutputs, sizeof(char *), CompareNamePtrs) != NULL)
+			{
+				Printf ("not built yet");
+			}
+			else
+			{
+				Printf ("can't be read");
+			}
+			if (maxlevel > 0)
+			{
+				Printf (" [level %d]", chain->Level);
+			}
+			Printf ("%s\n", chain->UpToDate ? ", up to date" : "");
+			continue;
+		}
+		for (j = 0; j < (int)(sizeof(OutputCosts)/sizeof(OutputCosts[0])); ++j)
+		{
+			if (OutputCosts[j].Type == step->Type)
+			{
+				double stepns = pixels * OutputCosts[j].NS;
+				double bytes = pixels * OutputCosts[j].Percent / 100;
+
+				Printf ("    %s %s: ~%s, ~%s\n",
+					step->Type == STEP_ConFont ? "confont" :
+					step->Type == STEP_Crosshair ? "xhair" :
+					step->Type == STEP_Image ? "image" : "font",
+					step->Name, FormatSize (sizebuf, bytes), FormatTime (timebuf, stepns));
+				ns += stepns;
+				if (!chain->UpToDate)
+				{
+					*written += bytes;
+				}
+			}
+		}
+	}
+	return chain->UpToDate ? 0 : ns;
+}
+
+// Prints the plan for every chain, script by script, then how long it
+// would all take. A level's chains run together, so the time for a level
+// is its share of the threads, unless one chain takes longer than that.
+static void PlanChains (Script *scripts, int numscripts, Chain *chains, int numchains, int maxlevel)
+{
+	char timebuf[32], sizebuf[32], totalbuf[32];
+	double *levelns, *longest;
+	double total = 0, wall = 0;
+	char **outputs;
+	int numoutputs, workers, i, j, level;
+
+	levelns = calloc (maxlevel + 1, sizeof(double));
+	longest = calloc (maxlevel + 1, sizeof(double));
+	if (levelns == NULL || longest == NULL)
+	{
+		fprintf (stderr, "Out of memory\n");
+		exit (20);
+	}
+	outputs = ListOutputs (chains, numchains, &numoutputs);
+
+	for (i = 0; i < numscripts; ++i)
+	{
+		double scriptns = 0, written = 0;
+		int loads = 0, uptodate = 0;
+
+		Printf ("%s:\n", scripts[i].Name);
+		for (j = 0; j < numchains; ++j)
+		{
+			double ns;
+
+			if (chains[j].Owner != &scripts[i])
+				continue;
+			ns = PlanChain (&chains[j], outputs, numoutputs, maxlevel, &written);
+			levelns[chains[j].Level] += ns;
+			if (ns > longest[chains[j].Level])
+				longest[chains[j].Level] = ns;
+			scriptns += ns;
+			uptodate += chains[j].UpToDate;
+			loads++;
+		}
+		Printf ("%s: %d loads, %d up to date, ~%s to write, ~%s of work\n",
+			scripts[i].Name, loads, uptodate, FormatSize (sizebuf, written),
+			FormatTime (timebuf, scriptns));
+		total += scriptns;
+	}
+
+	workers = NumWorkers ();
+	for (level = 0; level <= maxlevel; ++level)
+	{
+		wall += levelns[level] / workers > longest[level] ? levelns[level] / workers : longest[level];
+	}
+	Printf ("In all, ~%s with %d thread%s (~%s of work)\n",
+		FormatTime (timebuf, wall), workers, workers == 1 ? "" : "s",
+		FormatTime (totalbuf, total));
+
+	free (outputs);
+	free (levelns);
+	free (longest);
+}
+
+// Parses the scripts, then runs all of their steps. Each load starts a
+// chain of steps that only touches its own image, so chains run in
+// parallel unless one has to wait for another's files, even if it came
+// from another script. Messages are held and printed in script order,
+// so they come out the same every time.
+//
+// A database beside each script remembers what each output was built
+// from, so chains whose outputs are already up to date are skipped.
+static int BuildScripts (const Options *options, int numscripts, char **names,
+	FileWatch *watch, bool plan)
+{
+	LevelJobs jobs;
+	Script *scripts;
+	Chain *chains;
+	Step *step;
+	int numchains, maxlevel, flushed, uptodate, loads;
+	int failed, i, j, level;
+
+	scripts = calloc (numscripts, sizeof(Script));
+	if (scripts == NULL)
+	{
+		fprintf (stderr, "Out of memory\n");
+		exit (20);
+	}
+
+	failed = 0;
+	numchains = 0;
+	for (i = 0; i < numscripts; ++i)
+	{
+		int parsefailed;
+
+		scripts[i].Name = names[i];
+		scripts[i].LastStep = &scripts[i].FirstStep;
+		scripts[i].Opts = options;
+		scripts[i].Retrans = options->Retrans;
+		scripts[i].Watch = watch;
+		parsefailed = ParseScript (&scripts[i]);
+		if (parsefailed > failed)
+		{
+			failed = parsefailed;
+		}
+		ExpandLoops (&scripts[i]);
+		for (step = scripts[i].FirstStep; step != NULL; step = step->Next)
+		{
+			if (step == scripts[i].FirstStep || step->Type == STEP_Load)
+				numchains++;
+		}
+	}
+
+	chains = calloc (numchains + 1, sizeof(Chain));
+	jobs.Order = malloc ((numchains + 1) * sizeof(int));
+	if (chains == NULL || jobs.Order == NULL)
+	{
+		fprintf (stderr, "Out of memory\n");
+		exit (20);
+	}
+	jobs.Chains = chains;
+
+	for (i = 0, j = -1; i < numscripts; ++i)
+	{
+		for (step = scripts[i].FirstStep; step != NULL; step = step->Next)
+		{
+			if (step == scripts[i].FirstStep || step->Type == STEP_Load)
+			{
+				chains[++j].First = step;
+				chains[j].Owner = &scripts[i];
+			}
+			chains[j].NumSteps++;
+		}
+	}
+
+	maxlevel = LevelChains (chains, numchains);
+	if (watch != NULL)
+	{
+		WatchSources (watch, chains, numchains, numscripts, names);
+	}
+
+	// The CRC table must be built before the workers use it.
+	CRC32 (0, NULL, 0);
+	for (i = 0; i < numscripts; ++i)
+	{
+		LoadBuildDB (&scripts[i]);
+	}
+	if (plan)
+	{
+		PlanChains (scripts, numscripts, chains, numchains, maxlevel);
+	}
+	flushed = 0;
+	for (level = 0; level <= maxlevel && numchains > 0 && !plan; ++level)
+	{
+		for (i = j = 0; i < numchains; ++i)
+		{
+			if (chains[i].Level == level)
+				jobs.Order[j++] = i;
+		}
+		RunJobs (j, RunChain, &jobs);
+
+		// Print whatever can be printed without getting ahead of a
+		// chain that hasn't run yet.
+		for (; flushed < numchains && chains[flushed].Level <= level; ++flushed)
+		{
+			FlushLog (chains[flushed].Log);
+		}
+	}
+
+	if (!plan && options->WriteDeps &&
+		WriteScriptDeps (options, chains, numchains, numscripts, names, failed != 0) && failed < 20)
+	{
+		failed = 20;
+	}
+
+	for (i = 0; i < numscripts; ++i)
+	{
+		if (scripts[i].FirstStep == NULL)
+			continue;
+
+		if (!plan)
+		{
+			SaveBuildDB (&scripts[i], chains, numchains);
+		}
+		FreeBuildDB (&scripts[i]);
+
+		for (j = uptodate = loads = 0; j < numchains; ++j)
+		{
+			if (chains[j].Owner == &scripts[i])
+			{
+				uptodate += chains[j].UpToDate;
+				loads++;
+			}
+		}
+		if (uptodate > 0 && !plan)
+		{
+			Printf ("%s: %d of %d loads were already up to date\n",
+				scripts[i].Name, uptodate, loads);
+		}
+
+		FreeSteps (scripts[i].FirstStep);
+	}
+
+	for (i = 0; i < numchains; ++i)
+	{
+		FreeBuilt (&chains[i]);
+	}
+	free (jobs.Order);
+	free (chains);
+	free (scripts);
+	return failed;
+}
+
+int RunScripts (const Options *options, int numscripts, char **names)
+{
+	return BuildScripts (options, numscripts, names, NULL, false);
+}
+
+// Prints what running the scripts would do and about how long it would
+// take, without running them.
+int PlanScripts (const Options *options, int numscripts, char **names)
+{
+	return BuildScripts (options, numscripts, names, NULL, true);
+}
+
+// Runs the scripts, then runs them again whenever a file they read
+// changes. The build database keeps each run down to the chains whose
+// files changed. This never returns.
+int WatchScripts (const Options *options, int numscripts, char **names)
+{
+	Options watching = *options;
+
+	for (;;)
+	{
+		FileWatch *watch = NewFileWatch ();
+
+		BuildScripts (&watching, numscripts, names, watch, false);
+		Printf ("Waiting for changes...\n");
+		fflush (stdout);
+		WaitForChange (watch);
+		FreeFileWatch (watch);
+
+		// -a only applies to the first run.
+		watching.RebuildAll = false;
+	}
+}
@@ -0,0 +1,62 @@
+#ifndef SCRIPT_H
+#define SCRIPT_H
+
+/* The parser turns a script into a list of steps, which RunScripts runs
+ * once every script has been read.
+ */
+typedef enum
+{
+	STEP_Load,			// Name, Arg[0] = color to swap with 0
+	STEP_Origin,		// Arg[0] = x, Arg[1] = y
+	STEP_ConFont,		// Name
+	STEP_Crosshair,		// Name
+	STEP_Image,			// Name
+	STEP_StartFont,		// Name
+	STEP_GrabFont,		// Arg[0] = x, Arg[1] = y, Arg[2] = first character
+	STEP_Shading,		// Arg[0] = ShadeType
+	STEP_EndFont,
+	STEP_Foreach		// Name = pattern, Var, Body
+} StepType;
+
+typedef struct Step
+{
+	StepType Type;
+	char *Name;			// owned by the step
+	int Arg[3];
+	char *Var;			// the variable a loop sets, with its $
+	struct Step *Body;	// the steps inside a loop
+	struct Step *Next;
+} Step;
+
+typedef struct Script
+{
+	char *Name;
+	Step *FirstStep;
+	Step **LastStep;
+	const Options *Opts;			// from the command line
+	UBYTE Retrans;					// the color loads swap with 0
+	struct BuildRecord *Records;	// from the last time it was run
+	int NumRecords;
+	struct FileWatch *Watch;		// notes the files it reads, or NULL
+} Script;
+
+/* Where a parse is up to. The parser hands it to the scanner with each
+ * token, so neither of them keeps it in globals.
+ */
+typedef struct ParseContext
+{
+	Script *Owner;			// gets the steps that are parsed
+	const char *FileName;
+	int Line, Column;
+	void *Scanner;			// the scanner's yyscan_t
+} ParseContext;
+
+Step *AddStep (Script *script, StepType type, char *name, int arg0, int arg1, int arg2);
+Step *StartLoop (Script *script, char *pattern, char *var);
+void EndLoop (Script *script, Step *loop);
+int ParseScript (Script *script);
+int RunScripts (const Options *options, int numscripts, char **names);
+int WatchScripts (const Options *options, int numscripts, char **names);
+int PlanScripts (const Options *options, int numscripts, char **names);
+
+#endif
@@ -0,0 +1,768 @@
+/*
+** server.c
+** Runs commands sent by other programs, so that they don't have to start
+** imagetool over again for every file.
+**
+**---------------------------------------------------------------------------
+** Copyright 2001 Randy Heit
+** All rights reserved.
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions
+** are met:
+**
+** 1. Redistributions of source code must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. The name of the author may not be used to endorse or promote products
+**    derived from this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+** IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+** OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+** IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+** NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+** DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+** THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+** THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**---------------------------------------------------------------------------
+*/
+
+/* A request is one line holding the arguments of an imagetool command
+ * line, separated by tabs so that file names can have spaces in them:
+ *
+ *		image<TAB>sprites/a.pcx<TAB>out/a.imgz<LF>
+ *
+ * Files are read and written in place. A file that the server can't
+ * read itself can be sent ahead of the requests that use it:
+ *
+ *		input<TAB><name><TAB><length><LF><length bytes of the file>
+ *
+ * After that, requests on the same connection that name <name> read the
+ * copy the server kept. The name's extension still says what kind of
+ * image it is. The copy is deleted when the connection closes.
+ *
+ * The reply is every message the request printed, each one sent as
+ *
+ *		out <length><LF><text>		or		err <length><LF><text>
+ *
+ * followed by "done <exit code><LF>". The request "quit" stops the
+ * server once the requests that are running have finished. Every
+ * connection has its own thread, so clients don't wait for each other,
+ * and each request still spreads its work across the worker threads.
+ * Decoded images stay cached between requests.
+ */
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <signal.h>
+#include <pthread.h>
+#include <errno.h>
+#endif
+
+// Don't include afx.h here; its typedefs clash with windows.h.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "output.h"
+#include "server.h"
+#include "threads.h"
+
+#define MAX_REQUEST		65536
+#define MAX_ARGS		256
+
+// How long to wait before trying again when a connection can't be
+// accepted. It doubles each time it fails in a row.
+#define MIN_BACKOFF_MS	100
+#define MAX_BACKOFF_MS	5000
+
+#ifdef _WIN32
+typedef HANDLE Connection;
+#else
+typedef int Connection;
+#endif
+
+// A file that was sent with an input request.
+typedef struct
+{
+	char *Name;				// what requests call it
+	char *Path;				// where the server put it
+} Input;
+
+typedef struct Client
+{
+	struct Client *Next, *Prev;
+	Connection Conn;
+	int Failed;				// set once the other end stops listening
+	int Closing;			// set when a request leaves it out of step
+	int Pos, Len;
+	char Buffer[4096];
+	char Request[MAX_REQUEST];
+	Input *Inputs;
+	int NumInputs;
+} Client;
+
+static const char *ListenPath;
+static SpinLock ServerLock;
+static int Stopping;		// set by quit
+static int Running;			// requests that haven't been answered yet
+static Client *Clients;		// every connection that is open
+#ifdef _WIN32
+static volatile long TempCount;
+#endif
+
+static void Pause (int ms)
+{
+#ifdef _WIN32
+	Sleep (ms);
+#else
+	usleep (ms * 1000);
+#endif
+}
+
+static int ReadBytes (Connection conn, char *buf, int len)
+{
+#ifdef _WIN32
+	DWORD got;
+
+	if (!ReadFile (conn, buf, len, &got, NULL))
+		return -1;
+	return (int)got;
+#else
+	return (int)read (conn, buf, len);
+#endif
+}
+
+static void WriteBytes (Client *client, const char *buf, int len)
+{
+	while (len > 0 && !client->Failed)
+	{
+#ifdef _WIN32
+		DWORD put;
+
+		if (!WriteFile (client->Conn, buf, len, &put, NULL) || put == 0)
+#else
+		int put = (int)write (client->Conn, buf, len);
+
+		if (put <= 0)
+#endif
+		{
+			client->Failed = 1;
+			break;
+		}
+		buf += put;
+		len -= put;
+	}
+}
+
+// Makes sure there is something in the client's buffer. Returns 0 once
+// the other end has hung up.
+static int FillBuffer (Client *client)
+{
+	if (client->Pos == client->Len)
+	{
+		client->Pos = 0;
+		client->Len = ReadBytes (client->Conn, client->Buffer, sizeof(client->Buffer));
+		if (client->Len <= 0)
+		{
+			client->Len = 0;
+			return 0;
+		}
+	}
+	return 1;
+}
+
+// Reads the next request line into the client's Request. Returns 0 once
+// the other end has hung up. Requests that are too long are cut short.
+static int ReadRequest (Client *client)
+{
+	int len = 0;
+
+	for (;;)
+	{
+		char c;
+
+		if (!FillBuffer (client))
+			return 0;
+		c = client->Buffer[client->Pos++];
+		if (c == '\n')
+		{
+			if (len > 0 && client->Request[len-1] == '\r')
+				len--;
+			client->Request[len] = 0;
+			return 1;
+		}
+		if (len < MAX_REQUEST - 1)
+			client->Request[len++] = c;
+	}
+}
+
+// Copies the next len bytes from the client to f, or throws them away if
+// f is NULL. Returns 0 if the other end hangs up first. A failed write
+// is left for ferror to find, and the rest of the bytes are still read.
+static int ReceiveBytes (Client *client, FILE *f, long len)
+{
+	while (len > 0)
+	{
+		int chunk;
+
+		if (!FillBuffer (client))
+			return 0;
+		chunk = client->Len - client->Pos;
+		if (chunk > len)
+			chunk = (int)len;
+		if (f != NULL)
+			fwrite (client->Buffer + client->Pos, 1, chunk, f);
+		client->Pos += chunk;
+		len -= chunk;
+	}
+	return 1;
+}
+
+static void SendMessage (void *userdata, FILE *stream, const char *text)
+{
+	Client *client = (Client *)userdata;
+	char header[32];
+	int len = strlen (text);
+
+	sprintf (header, "%s %d\n", stream == stderr ? "err" : "out", len);
+	WriteBytes (client, header, strlen (header));
+	WriteBytes (client, text, len);
+}
+
+// Opens a new file to hold an input called name, with the same extension
+// so that it is read the same way. Returns NULL if it can't.
+static FILE *MakeInputFile (const char *name, char **path)
+{
+	const char *ext = strrchr (name, '.');
+	FILE *f;
+#ifdef _WIN32
+	char dir[MAX_PATH];
+
+	if (ext == NULL || strpbrk (ext, "/\\") != NULL)
+		ext = "";
+	if (GetTempPath (sizeof(dir), dir) == 0)
+		strcpy (dir, ".\\");
+	*path = malloc (strlen (dir) + strlen (ext) + 40);
+	if (*path == NULL)
+	{
+		fprintf (stderr, "Out of memory\n");
+		exit (20);
+	}
+	// The process ID keeps this apart from other servers' files.
+	sprintf (*path, "%simagetool-%lu-%ld%s", dir, (unsigned long)GetCurrentProcessId (),
+		InterlockedIncrement (&TempCount), ext);
+	f = fopen (*path, "wb");
+#else
+	const char *dir = getenv ("TMPDIR");
+	int fd;
+
+	if (ext == NULL || strchr (ext, '/') != NULL)
+		ext = "";
+	if (dir == NULL || dir[0] == 0)
+		dir = "/tmp";
+	*path = malloc (strlen (dir) + strlen (ext) + 20);
+	if (*path == NULL)
+	{
+		fprintf (stderr, "Out of memory\n");
+		exit (20);
+	}
+	sprintf (*path, "%s/imagetool-XXXXXX%s", dir, ext);
+	fd = mkstemps (*path, strlen (ext));
+	f = fd >= 0 ? fdopen (fd, "wb") : NULL;
+	if (f == NULL && fd >= 0)
+	{
+		close (fd);
+		remove (*path);
+	}
+#endif
+	if (f == NULL)
+	{
+		free (*path);
+		*path = NULL;
+	}
+	return f;
+}
+
+// Remembers that the input called name is at path, replacing any input
+// that had that name before.
+static void AddInput (Client *client, const char *name, char *path)
+{
+	Input *input;
+	int i;
+
+	for (i = 0; i < client->NumInputs; ++i)
+	{
+		if (strcmp (client->Inputs[i].Name, name) == 0)
+		{
+			input = &client->Inputs[i];
+			ForgetPic (input->Path);
+			remove (input->Path);
+			free (input->Path);
+			input->Path = path;
+			return;
+		}
+	}
+	input = realloc (client->Inputs, (client->NumInputs + 1) * sizeof(Input));
+	if (input == NULL || (input[client->NumInputs].Name = strdup (name)) == NULL)
+	{
+		fprintf (stderr, "Out of memory\n");
+		exit (20);
+	}
+	client->Inputs = input;
+	client->Inputs[client->NumInputs++].Path = path;
+}
+
+static void FreeInputs (Client *client)
+{
+	int i;
+
+	for (i = 0; i < client->NumInputs; ++i)
+	{
+		ForgetPic (client->Inputs[i].Path);
+		remove (client->Inputs[i].Path);
+		free (client->Inputs[i].Path);
+		free (client->Inputs[i].Name);
+	}
+	free (client->Inputs);
+	client->Inputs = NULL;
+	client->NumInputs = 0;
+}
+
+// Takes in a file sent by an input request; args is the rest of its
+// line. Returns the exit code. If the length can't be read, there is no
+// telling where the next request starts, so the connection is closed.
+static int ReceiveInput (Client *client, char *args)
+{
+	char *tab = strrchr (args, '\t');
+	char *end, *path;
+	long len;
+	FILE *f;
+	int failed;
+
+	if (tab == NULL || tab == args ||
+		(len = strtol (tab + 1, &end, 10)) < 0 || end == tab + 1 || *end != 0)
+	{
+		Eprintf ("An input needs a name and a length\n");
+		client->Closing = 1;
+		return 10;
+	}
+	*tab = 0;
+
+	f = MakeInputFile (args, &path);
+	if (f == NULL)
+	{
+		Eprintf ("Could not make a file to hold %s\n", args);
+		if (!ReceiveBytes (client, NULL, len))
+			client->Closing = 1;
+		return 20;
+	}
+	if (!ReceiveBytes (client, f, len))
+	{
+		client->Closing = 1;
+	}
+	failed = ferror (f);
+	failed |= fclose (f);
+	if (failed || client->Closing)
+	{
+		if (failed)
+			Eprintf ("Could not write %s\n", path);
+		remove (path);
+		free (path);
+		return 20;
+	}
+	AddInput (client, args, path);
+	return 0;
+}
+
+// Splits the command in the client's Request into arguments and runs it.
+// Names of inputs are swapped for where their files are.
+static int RunRequest (Client *client)
+{
+	char *argv[MAX_ARGS + 1];
+	char *arg;
+	int argc, i, j;
+
+	argv[0] = "imagetool";
+	argc = 1;
+	for (arg = client->Request; *arg != 0 && argc < MAX_ARGS; )
+	{
+		argv[argc++] = arg;
+		arg = strchr (arg, '\t');
+		if (arg == NULL)
+			break;
+		*arg++ = 0;
+	}
+	argv[argc] = NULL;
+
+	for (i = 1; i < argc; ++i)
+	{
+		for (j = 0; j < client->NumInputs; ++j)
+		{
+			if (strcmp (argv[i], client->Inputs[j].Name) == 0)
+			{
+				argv[i] = client->Inputs[j].Path;
+				break;
+			}
+		}
+	}
+	return RunCommand (argc, argv, 1);
+}
+
+// Makes the listener's wait for a connection return, by connecting to it.
+static void WakeListener (void)
+{
+#ifdef _WIN32
+	HANDLE pipe;
+
+	if (WaitNamedPipe (ListenPath, 2000))
+	{
+		pipe = CreateFile (ListenPath, GENERIC_READ | GENERIC_WRITE, 0, NULL,
+			OPEN_EXISTING, 0, NULL);
+		if (pipe != INVALID_HANDLE_VALUE)
+			CloseHandle (pipe);
+	}
+#else
+	struct sockaddr_un addr;
+	int sock = socket (AF_UNIX, SOCK_STREAM, 0);
+
+	if (sock < 0)
+		return;
+	memset (&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strcpy (addr.sun_path, ListenPath);
+	connect (sock, (struct sockaddr *)&addr, sizeof(addr));
+	close (sock);
+#endif
+}
+
+static int IsStopping (void)
+{
+	int stopping;
+
+	Lock (&ServerLock);
+	stopping = Stopping;
+	Unlock (&ServerLock);
+	return stopping;
+}
+
+// Runs the request in the client's Request and sends back the reply.
+static void HandleRequest (Client *client)
+{
+	char done[32];
+	OutputLog *log;
+	int result, stopping;
+
+	if (strcmp (client->Request, "quit") == 0)
+	{
+		WriteBytes (client, "done 0\n", 7);
+		Lock (&ServerLock);
+		Stopping = 1;
+		Unlock (&ServerLock);
+		WakeListener ();
+		client->Closing = 1;
+		return;
+	}
+
+	// Once quit has come, nothing new starts.
+	Lock (&ServerLock);
+	stopping = Stopping;
+	if (!stopping)
+		Running++;
+	Unlock (&ServerLock);
+
+	log = StartLog ();
+	if (stopping)
+	{
+		Eprintf ("The server is stopping\n");
+		client->Closing = 1;
+		result = 20;
+	}
+	else if (strncmp (client->Request, "input\t", 6) == 0)
+	{
+		result = ReceiveInput (client, client->Request + 6);
+	}
+	else
+	{
+		result = RunRequest (client);
+	}
+	EndLog ();
+
+	WalkLog (log, SendMessage, client);
+	FreeLog (log);
+	if (result == BAD_USAGE)
+	{
+		SendMessage (client, stderr, "bad request\n");
+		result = 10;
+	}
+	sprintf (done, "done %d\n", result);
+	WriteBytes (client, done, strlen (done));
+
+	if (!stopping)
+	{
+		Lock (&ServerLock);
+		Running--;
+		Unlock (&ServerLock);
+	}
+}
+
+// Waits for the requests that are running to finish, so that the server
+// doesn't quit halfway through writing their files. Nothing new starts
+// once quit has come, so then the inputs of clients that are still
+// connected can be deleted out from under them.
+static void StopClients (void)
+{
+	Client *client;
+	int running;
+
+	for (;;)
+	{
+		Lock (&ServerLock);
+		running = Running;
+		if (running == 0)
+		{
+			for (client = Clients; client != NULL; client = client->Next)
+			{
+				FreeInputs (client);
+			}
+		}
+		Unlock (&ServerLock);
+		if (running == 0)
+			break;
+		Pause (20);
+	}
+}
+
+static void ServeClient (Client *client)
+{
+	while (!client->Failed && !client->Closing && ReadRequest (client))
+	{
+		HandleRequest (client);
+	}
+	Lock (&ServerLock);
+	FreeInputs (client);
+	if (client->Prev != NULL)
+		client->Prev->Next = client->Next;
+	else
+		Clients = client->Next;
+	if (client->Next != NULL)
+		client->Next->Prev = client->Prev;
+	Unlock (&ServerLock);
+
+#ifdef _WIN32
+	FlushFileBuffers (client->Conn);
+	DisconnectNamedPipe (client->Conn);
+	CloseHandle (client->Conn);
+#else
+	close (client->Conn);
+#endif
+	free (client);
+}
+
+#ifdef _WIN32
+static DWORD WINAPI ClientThread (LPVOID arg)
+{
+	ServeClient ((Client *)arg);
+	return 0;
+}
+#else
+static void *ClientThread (void *arg)
+{
+	ServeClient ((Client *)arg);
+	return NULL;
+}
+#endif
+
+// Gives a new connection a thread of its own.
+static void StartClient (Connection conn)
+{
+	Client *client = calloc (1, sizeof(Client));
+#ifdef _WIN32
+	HANDLE thread;
+#else
+	pthread_t thread;
+#endif
+
+	if (client == NULL)
+	{
+		fprintf (stderr, "Out of memory\n");
+		exit (20);
+	}
+	client->Conn = conn;
+	Lock (&ServerLock);
+	client->Next = Clients;
+	if (Clients != NULL)
+		Clients->Prev = client;
+	Clients = client;
+	Unlock (&ServerLock);
+
+#ifdef _WIN32
+	thread = CreateThread (NULL, 0, ClientThread, client, 0, NULL);
+	if (thread != NULL)
+	{
+		CloseHandle (thread);
+		return;
+	}
+#else
+	if (pthread_create (&thread, NULL, ClientThread, client) == 0)
+	{
+		pthread_detach (thread);
+		return;
+	}
+#endif
+	// ServeClient cleans up the same way when the client leaves.
+	fprintf (stderr, "Could not start a thread for a client\n");
+	client->Closing = 1;
+	ServeClient (client);
+}
+
+#ifdef _WIN32
+
+int Serve (const char *path)
+{
+	char pipename[MAX_PATH];
+	int backoff = MIN_BACKOFF_MS;
+	int result = 0;
+
+	// Named pipes all live under \\.\pipe\, so plain names go there.
+	if (strncmp (path, "\\\\.\\pipe\\", 9) == 0)
+		_snprintf (pipename, sizeof(pipename), "%s", path);
+	else
+		_snprintf (pipename, sizeof(pipename), "\\\\.\\pipe\\%s", path);
+	pipename[sizeof(pipename)-1] = 0;
+	ListenPath = pipename;
+
+	// Find out how many workers there are before the clients' threads
+	// ask at the same time.
+	NumWorkers ();
+
+	printf ("Serving on %s\n", pipename);
+	fflush (stdout);
+
+	while (!IsStopping ())
+	{
+		HANDLE conn = CreateNamedPipe (pipename, PIPE_ACCESS_DUPLEX,
+			PIPE_TYPE_BYTE | PIPE_READMODE_BYTE | PIPE_WAIT,
+			PIPE_UNLIMITED_INSTANCES, 65536, 65536, 0, NULL);
+
+		if (conn == INVALID_HANDLE_VALUE)
+		{
+			fprintf (stderr, "Could not create %s\n", pipename);
+			result = 20;
+			break;
+		}
+		if (!ConnectNamedPipe (conn, NULL) && GetLastError () != ERROR_PIPE_CONNECTED)
+		{
+			DWORD error = GetLastError ();
+
+			CloseHandle (conn);
+			// The client already left; that is no reason to wait.
+			if (error == ERROR_NO_DATA)
+				continue;
+			fprintf (stderr, "Could not connect a client (error %lu); trying again in %d ms\n",
+				(unsigned long)error, backoff);
+			Pause (backoff);
+			backoff = backoff * 2 < MAX_BACKOFF_MS ? backoff * 2 : MAX_BACKOFF_MS;
+			continue;
+		}
+		backoff = MIN_BACKOFF_MS;
+		if (IsStopping ())
+		{
+			DisconnectNamedPipe (conn);
+			CloseHandle (conn);
+			break;
+		}
+		StartClient (conn);
+	}
+	StopClients ();
+	return result;
+}
+
+#else
+
+int Serve (const char *path)
+{
+	struct sockaddr_un addr;
+	int listener;
+	int backoff = MIN_BACKOFF_MS;
+	int result = 0;
+
+	if (strlen (path) >= sizeof(addr.sun_path))
+	{
+		fprintf (stderr, "%s is too long for a socket name\n", path);
+		return 20;
+	}
+	memset (&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	strcpy (addr.sun_path, path);
+	ListenPath = path;
+
+	// A client that hangs up early shouldn't take the server with it.
+	signal (SIGPIPE, SIG_IGN);
+
+	// Find out how many workers there are before the clients' threads
+	// ask at the same time.
+	NumWorkers ();
+
+	unlink (path);
+	listener = socket (AF_UNIX, SOCK_STREAM, 0);
+	if (listener < 0 ||
+		bind (listener, (struct sockaddr *)&addr, sizeof(addr)) != 0 ||
+		listen (listener, 16) != 0)
+	{
+		fprintf (stderr, "Could not listen on %s\n", path);
+		if (listener >= 0)
+			close (listener);
+		return 20;
+	}
+
+	printf ("Serving on %s\n", path);
+	fflush (stdout);
+
+	while (!IsStopping ())
+	{
+		int conn = accept (listener, NULL, NULL);
+
+		if (conn < 0)
+		{
+			// These go away on their own, once a client leaves or some
+			// memory is freed. Anything else means the socket is broken.
+			if (errno == EINTR || errno == ECONNABORTED)
+				continue;
+			if (errno != EMFILE && errno != ENFILE && errno != ENOBUFS && errno != ENOMEM)
+			{
+				fprintf (stderr, "Could not accept a client: %s\n", strerror (errno));
+				result = 20;
+				break;
+			}
+			fprintf (stderr, "Could not accept a client: %s; trying again in %d ms\n",
+				strerror (errno), backoff);
+			Pause (backoff);
+			backoff = backoff * 2 < MAX_BACKOFF_MS ? backoff * 2 : MAX_BACKOFF_MS;
+			continue;
+		}
+		backoff = MIN_BACKOFF_MS;
+		if (IsStopping ())
+		{
+			close (conn);
+			break;
+		}
+		StartClient (conn);
+	}
+	close (listener);
+	unlink (path);
+	StopClients ();
+	return result;
+}
+
+#endif
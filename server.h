@@ -0,0 +1,16 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+/* RunCommand returns this when its arguments don't make sense. */
+#define BAD_USAGE		-1
+
+/* Serve waits for commands on a socket, or a named pipe on Windows, and
+ * runs them until one of them is "quit". RunCommand, from imagetool.c,
+ * runs one command line's worth of work, and ForgetPic, from
+ * imageread.c, drops a file from the image cache.
+ */
+int Serve (const char *path);
+int RunCommand (int argc, char **argv, int served);
+void ForgetPic (const char *filename);
+
+#endif
@@ -0,0 +1,335 @@
+/*
+** threads.c
+** A minimal worker pool for running independent jobs in parallel.
+**
+**---------------------------------------------------------------------------
+** Copyright 2001 Randy Heit
+** All rights reserved.
+**
+** Redistribution and use in source and binary forms, with or without
+** modification, are permitted provided that the following conditions
+** are met:
+**
+** 1. Redistributions of source code must retain the above copyright
+**    notice, this list of conditions and the following disclaimer.
+** 2. Redistributions in binary form must reproduce the above copyright
+**    notice, this list of conditions and the following disclaimer in the
+**    documentation and/or other materials provided with the distribution.
+** 3. The name of the author may not be used to endorse or promote products
+**    derived from this software without specific prior written permission.
+**
+** THIS SOFTWARE IS PROVIDED BY THE AUTHOR ``AS IS'' AND ANY EXPRESS OR
+** IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+** OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+** IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR ANY DIRECT, INDIRECT,
+** INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+** NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+** DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+** THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+** (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+** THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+**---------------------------------------------------------------------------
+*/
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <errno.h>
+#endif
+
+// Don't include afx.h here; its typedefs clash with windows.h.
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "threads.h"
+
+#define MAX_WORKERS		64
+
+// How long a helper waits for a jobserver token before it looks to see
+// whether there is still any work left.
+#define TOKEN_WAIT_MS	20
+
+typedef struct
+{
+	JobFunc Func;
+	void *UserData;
+	int NumJobs;
+	volatile long NextJob;
+} JobList;
+
+static int Workers;
+
+// When run by a parallel make, the helpers each hold one of its tokens
+// while running a job, so that imagetool doesn't use more of the CPU
+// than make allows. The calling thread uses the token make started this
+// process with.
+static int UseJobserver;
+#ifdef _WIN32
+static HANDLE JobSemaphore;
+#else
+static int JobRead = -1, JobWrite = -1;
+#endif
+
+// Set while a thread is working on jobs that were spread across several
+// threads. Jobs started from there just run on that thread, since the
+// other workers are busy already.
+static THREAD_LOCAL int InParallelJob;
+
+// Returns the job number this worker should do next. Every worker
+// pulls from the same counter, so jobs are handed out in order but
+// may finish in any order.
+static int GrabJob (JobList *list)
+{
+#ifdef _WIN32
+	return InterlockedIncrement (&list->NextJob) - 1;
+#else
+	return __sync_fetch_and_add (&list->NextJob, 1);
+#endif
+}
+
+// Looks in MAKEFLAGS for make's jobserver. Newer makes call it
+// --jobserver-auth and older ones --jobserver-fds. It is either a pair of
+// pipe descriptors, a fifo (make 4.4), or a semaphore on Windows.
+static void JoinJobserver (void)
+{
+	const char *flags = getenv ("MAKEFLAGS");
+	const char *auth = NULL;
+	const char *p;
+	char value[256];
+	int len;
+
+	if (flags == NULL)
+		return;
+
+	// If there is more than one, the last one counts.
+	for (p = flags; (p = strstr (p, "--jobserver-")) != NULL; ++p)
+	{
+		if (strncmp (p + 12, "auth=", 5) == 0)
+			auth = p + 17;
+		else if (strncmp (p + 12, "fds=", 4) == 0)
+			auth = p + 16;
+	}
+	if (auth == NULL)
+		return;
+	len = strcspn (auth, " ");
+	if (len == 0 || len >= (int)sizeof(value))
+		return;
+	memcpy (value, auth, len);
+	value[len] = 0;
+
+#ifdef _WIN32
+	JobSemaphore = OpenSemaphore (SEMAPHORE_ALL_ACCESS, FALSE, value);
+	UseJobserver = JobSemaphore != NULL;
+#else
+	if (strncmp (value, "fifo:", 5) == 0)
+	{
+		JobRead = open (value + 5, O_RDONLY | O_NONBLOCK);
+		if (JobRead >= 0)
+			JobWrite = open (value + 5, O_WRONLY);
+	}
+	else
+	{
+		int readfd, writefd;
+		char path[32];
+
+		// make only passes the pipe on to commands it knows run make, so
+		// check that the descriptors are really open.
+		if (sscanf (value, "%d,%d", &readfd, &writefd) != 2 ||
+			fcntl (readfd, F_GETFD) == -1 || fcntl (writefd, F_GETFD) == -1)
+			return;
+
+		// Another process can take the token between poll and read, so
+		// reading must not block. Making make's descriptor non-blocking
+		// would change it for everybody, so try for one of our own.
+		sprintf (path, "/proc/self/fd/%d", readfd);
+		JobRead = open (path, O_RDONLY | O_NONBLOCK);
+		if (JobRead < 0)
+			JobRead = readfd;
+		JobWrite = writefd;
+	}
+	UseJobserver = JobRead >= 0 && JobWrite >= 0;
+#endif
+}
+
+// Waits up to ms milliseconds for a token from the jobserver.
+static int TakeToken (char *token, int ms)
+{
+#ifdef _WIN32
+	*token = 0;
+	return WaitForSingleObject (JobSemaphore, ms) == WAIT_OBJECT_0;
+#else
+	struct pollfd fd;
+
+	fd.fd = JobRead;
+	fd.events = POLLIN;
+	if (poll (&fd, 1, ms) <= 0)
+		return 0;
+	return read (JobRead, token, 1) == 1;
+#endif
+}
+
+static void ReturnToken (char token)
+{
+#ifdef _WIN32
+	ReleaseSemaphore (JobSemaphore, 1, NULL);
+#else
+	while (write (JobWrite, &token, 1) != 1 && errno == EINTR)
+		;
+#endif
+}
+
+// Returns false if the jobs ran out before a token came.
+static int WaitForToken (JobList *list, char *token)
+{
+	while (list->NextJob < list->NumJobs)
+	{
+		if (TakeToken (token, TOKEN_WAIT_MS))
+			return 1;
+	}
+	return 0;
+}
+
+static void WorkLoop (JobList *list, int parallel, int helper)
+{
+	int needtoken = helper && UseJobserver;
+	int job;
+	char token;
+
+	InParallelJob += parallel;
+	for (;;)
+	{
+		if (needtoken && !WaitForToken (list, &token))
+			break;
+		job = GrabJob (list);
+		if (job < list->NumJobs)
+			list->Func (list->UserData, job);
+		if (needtoken)
+			ReturnToken (token);
+		if (job >= list->NumJobs)
+			break;
+	}
+	InParallelJob -= parallel;
+}
+
+#ifdef _WIN32
+static DWORD WINAPI WorkThread (LPVOID arg)
+{
+	WorkLoop ((JobList *)arg, 1, 1);
+	return 0;
+}
+#else
+static void *WorkThread (void *arg)
+{
+	WorkLoop ((JobList *)arg, 1, 1);
+	return NULL;
+}
+#endif
+
+int NumWorkers (void)
+{
+	if (Workers == 0)
+	{
+		char *env = getenv ("IMAGETOOL_THREADS");
+
+		if (env != NULL)
+		{
+			Workers = atoi (env);
+		}
+		if (Workers <= 0)
+		{
+#ifdef _WIN32
+			SYSTEM_INFO info;
+			GetSystemInfo (&info);
+			Workers = info.dwNumberOfProcessors;
+#else
+			Workers = (int)sysconf (_SC_NPROCESSORS_ONLN);
+#endif
+		}
+		if (Workers < 1)
+			Workers = 1;
+		else if (Workers > MAX_WORKERS)
+			Workers = MAX_WORKERS;
+		JoinJobserver ();
+	}
+	return Workers;
+}
+
+// Runs func for every job in [0,numjobs) and returns once all of them are
+// done. The calling thread works too, so with only one worker (or only one
+// job), everything happens on the caller's thread. Under a parallel make,
+// the other threads only run a job while they hold a token from it.
+void RunJobs (int numjobs, JobFunc func, void *userdata)
+{
+	JobList list;
+	int numthreads, i;
+#ifdef _WIN32
+	HANDLE threads[MAX_WORKERS];
+#else
+	pthread_t threads[MAX_WORKERS];
+#endif
+
+	if (numjobs <= 0)
+		return;
+
+	list.Func = func;
+	list.UserData = userdata;
+	list.NumJobs = numjobs;
+	list.NextJob = 0;
+
+	numthreads = InParallelJob ? 1 : NumWorkers ();
+	if (numthreads > numjobs)
+		numthreads = numjobs;
+
+	// Start the helpers. If one can't be started, we just make do with
+	// fewer of them.
+	for (i = 0; i < numthreads - 1; ++i)
+	{
+#ifdef _WIN32
+		threads[i] = CreateThread (NULL, 0, WorkThread, &list, 0, NULL);
+		if (threads[i] == NULL)
+			break;
+#else
+		if (pthread_create (&threads[i], NULL, WorkThread, &list) != 0)
+			break;
+#endif
+	}
+	numthreads = i;
+
+	WorkLoop (&list, numthreads > 0, 0);
+
+	for (i = 0; i < numthreads; ++i)
+	{
+#ifdef _WIN32
+		WaitForSingleObject (threads[i], INFINITE);
+		CloseHandle (threads[i]);
+#else
+		pthread_join (threads[i], NULL);
+#endif
+	}
+}
+
+void Lock (SpinLock *lock)
+{
+#ifdef _WIN32
+	while (InterlockedExchange (lock, 1) != 0)
+		Sleep (0);
+#else
+	while (__sync_lock_test_and_set (lock, 1) != 0)
+		sched_yield ();
+#endif
+}
+
+void Unlock (SpinLock *lock)
+{
+#ifdef _WIN32
+	InterlockedExchange (lock, 0);
+#else
+	__sync_lock_release (lock);
+#endif
+}
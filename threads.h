@@ -0,0 +1,26 @@
+#ifndef THREADS_H
+#define THREADS_H
+
+/* A job function is called once for every job number in [0,numjobs).
+ * Jobs may run concurrently and in any order, so they must only write
+ * to memory that belongs to their own job number.
+ */
+typedef void (*JobFunc) (void *userdata, int job);
+
+#ifdef _MSC_VER
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL __thread
+#endif
+
+/* A lock for short stretches of code that touch shared data. Start it
+ * out as 0.
+ */
+typedef volatile long SpinLock;
+
+int NumWorkers (void);
+void RunJobs (int numjobs, JobFunc func, void *userdata);
+void Lock (SpinLock *lock);
+void Unlock (SpinLock *lock);
+
+#endif